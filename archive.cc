@@ -0,0 +1,171 @@
+#include "archive.h"
+#include "async_file_io.h"
+
+#include <filesystem>
+#include <fstream>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+
+using namespace testing;
+
+namespace {
+std::filesystem::path scratch_dir(const std::string& name)
+{
+    auto path = std::filesystem::temp_directory_path() / ("rateless_codes_" + name);
+    std::filesystem::remove_all(path);
+    std::filesystem::create_directories(path);
+    return path;
+}
+
+std::vector<char> read_file(const std::filesystem::path& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+} // namespace
+
+TEST(AsyncFileIo, WriteThenReadBack)
+{
+    using namespace Codes::Fountain;
+    auto path = scratch_dir("async_io") / "data";
+    auto fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    ASSERT_GE(fd, 0);
+
+    std::vector<std::vector<char>> chunks(100, std::vector<char>(512));
+    for (auto idx = 0u; idx < chunks.size(); ++idx)
+        std::fill(chunks[idx].begin(), chunks[idx].end(), static_cast<char>(idx));
+
+    AsyncFileIo io(8);
+    // more requests than ring entries, in reverse order
+    for (auto idx = chunks.size(); idx-- > 0;)
+        io.write(fd, chunks[idx].data(), chunks[idx].size(), idx * 512);
+    ASSERT_TRUE(io.wait());
+
+    std::vector<char> back(chunks.size() * 512);
+    for (auto idx = 0u; idx < chunks.size(); ++idx)
+        io.read(fd, back.data() + idx * 512, 512, idx * 512);
+    ASSERT_TRUE(io.wait());
+    for (auto idx = 0u; idx < chunks.size(); ++idx)
+        ASSERT_EQ(memcmp(back.data() + idx * 512, chunks[idx].data(), 512), 0);
+
+    // reading past the end is short, failures are told per request
+    EXPECT_EQ(io.read(fd, back.data(), 512, 0), 0u);
+    auto short_read = io.read(fd, back.data() + 512, 512, back.size());
+    EXPECT_FALSE(io.wait());
+    EXPECT_THAT(io.failed(), ElementsAre(short_read));
+    ASSERT_TRUE(io.wait());
+    EXPECT_TRUE(io.failed().empty());
+    close(fd);
+}
+
+TEST(AsyncFileIo, PoolQueuesWhileRunning)
+{
+    using namespace Codes::Fountain;
+    auto dir = scratch_dir("async_io_pool");
+    auto source = open((dir / "source").c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    auto target = open((dir / "target").c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    ASSERT_GE(source, 0);
+    ASSERT_GE(target, 0);
+
+    std::vector<char> data(2000 * 64);
+    for (auto idx = 0u; idx < data.size(); ++idx)
+        data[idx] = static_cast<char>(idx * 13 + idx / 64);
+    ASSERT_EQ(pwrite(source, data.data(), data.size(), 0), static_cast<ssize_t>(data.size()));
+
+    AsyncFileIo io(8, false);
+    EXPECT_FALSE(io.uses_uring());
+    // like archive blocks, the next batch is queued while writes still run
+    for (auto idx = 0u; idx < 2000; ++idx)
+        io.write(target, data.data() + idx * 64, 64, idx * 64);
+    io.submit();
+    std::vector<char> back(data.size());
+    for (auto idx = 0u; idx < 2000; ++idx)
+        io.read(source, back.data() + idx * 64, 64, idx * 64);
+    ASSERT_TRUE(io.wait());
+    EXPECT_EQ(back, data);
+    EXPECT_EQ(read_file(dir / "target"), data);
+    close(source);
+    close(target);
+}
+
+TEST(Archive, RestoreWithLostAndDamagedShards)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto root = scratch_dir("archive");
+    std::vector<std::string> directories;
+    for (auto idx = 0; idx < 3; ++idx)
+    {
+        directories.push_back((root / ("disk" + std::to_string(idx))).string());
+        std::filesystem::create_directories(directories.back());
+    }
+
+    // not a multiple of the block or symbol size
+    std::vector<char> data(100'003);
+    for (auto idx = 0u; idx < data.size(); ++idx)
+        data[idx] = static_cast<char>(idx * 7 + idx / 251);
+    auto input = root / "input";
+    std::ofstream(input, std::ios::binary).write(data.data(), static_cast<std::streamsize>(data.size()));
+
+    Archive::Options options;
+    options.symbol_length = 256;
+    options.block_symbols = 64;
+    options.repair_symbols = 48;
+    options.shards = 6;
+    options.seed = 13;
+    ASSERT_TRUE(Archive::encode(input.string(), "backup", directories, options));
+
+    // one shard is gone, one is cut short and one got a flipped byte
+    std::filesystem::remove(Archive::shard_path(directories[1], "backup", 1));
+    auto truncated = Archive::shard_path(directories[2], "backup", 5);
+    std::filesystem::resize_file(truncated, std::filesystem::file_size(truncated) / 2);
+    {
+        std::fstream damaged(Archive::shard_path(directories[0], "backup", 3),
+                             std::ios::binary | std::ios::in | std::ios::out);
+        damaged.seekp(Archive::header_size + 100);
+        damaged.put('\x5a');
+    }
+    // shards may be moved between disks
+    std::filesystem::rename(Archive::shard_path(directories[0], "backup", 0),
+                            Archive::shard_path(directories[2], "backup", 0));
+
+    auto output = root / "output";
+    ASSERT_TRUE(Archive::decode("backup", directories, output.string()));
+    EXPECT_EQ(read_file(output), data);
+
+    // with three of six shards gone a block does not have enough symbols left
+    std::filesystem::remove(Archive::shard_path(directories[2], "backup", 0));
+    std::filesystem::remove(Archive::shard_path(directories[0], "backup", 3));
+    EXPECT_FALSE(Archive::decode("backup", directories, output.string()));
+    // the earlier restore is left in place
+    EXPECT_EQ(read_file(output), data);
+    EXPECT_FALSE(std::filesystem::exists(output.string() + ".partial"));
+}
+
+TEST(Archive, ZeroSeed)
+{
+    using namespace Codes::Fountain;
+    auto root = scratch_dir("archive_zero_seed");
+    std::vector<char> data(40'000);
+    for (auto idx = 0u; idx < data.size(); ++idx)
+        data[idx] = static_cast<char>(idx * 31);
+    auto input = root / "input";
+    std::ofstream(input, std::ios::binary).write(data.data(), static_cast<std::streamsize>(data.size()));
+
+    Archive::Options options;
+    options.symbol_length = 128;
+    options.block_symbols = 64;
+    options.repair_symbols = 32;
+    options.shards = 4;
+    ASSERT_TRUE(Archive::encode(input.string(), "zero", {root.string()}, options));
+    std::filesystem::remove(Archive::shard_path(root.string(), "zero", 2));
+
+    auto output = root / "output";
+    ASSERT_TRUE(Archive::decode("zero", {root.string()}, output.string()));
+    EXPECT_EQ(read_file(output), data);
+}
@@ -0,0 +1,225 @@
+#include "async_decoder.h"
+#include "robust_soliton_distribution.h"
+#include "thread_pool.h"
+
+#include <future>
+#include <utility>
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+
+using namespace testing;
+
+namespace {
+// Eagerly started coroutine without result, enough to drive awaiters
+struct Detached
+{
+    struct promise_type
+    {
+        Detached get_return_object()
+        {
+            return {};
+        }
+        std::suspend_never initial_suspend()
+        {
+            return {};
+        }
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+        void return_void() {}
+        void unhandled_exception()
+        {
+            std::terminate();
+        }
+    };
+};
+
+// Cancels once the first input is recovered, as a cancel() from another
+// thread would while decode() runs
+struct CancellingObserver
+{
+    void symbol_fed(size_t, size_t) {}
+    void symbol_released(size_t, size_t) {}
+    void input_decoded(size_t, size_t)
+    {
+        if (cancel)
+            std::exchange(cancel, {})();
+    }
+    void ripple_empty(size_t) {}
+
+    std::function<void()> cancel;
+};
+
+template <typename Codec>
+Detached wait_completed(Codec& decoder, std::promise<bool>& result)
+{
+    result.set_value(co_await decoder.completed());
+}
+
+template <typename Codec>
+Detached release_when_completed(std::unique_ptr<Codec>& decoder, size_t& completions)
+{
+    co_await decoder->completed();
+    ++completions;
+    decoder.reset();
+}
+
+template <typename Codec>
+Detached collect_ranges(Codec& decoder, std::vector<Codes::Fountain::DecodedRange>& ranges, bool& finished)
+{
+    while (auto range = co_await decoder.next_range())
+        ranges.push_back(*range);
+    finished = true;
+}
+} // namespace
+
+TEST(AsyncDecoder, ProgressiveRanges)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto symbol_length = 8u;
+    auto input_symbols = 500u;
+    auto total_data_size = symbol_length * input_symbols;
+    auto seed = 13u;
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 3);
+
+    LT encoder(new RobustSolitonDistribution(0.05, 0.03));
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    BasicLT<ProgressObserver> decoder(new RobustSolitonDistribution(0.05, 0.03));
+    decoder.set_seed(seed);
+    decoder.set_input_data_size(total_data_size);
+    decoder.set_symbol_length(symbol_length);
+    AsyncDecoder async(decoder);
+
+    std::promise<bool> completed;
+    std::vector<DecodedRange> ranges;
+    bool finished = false;
+    wait_completed(async, completed);
+    collect_ranges(async, ranges, finished);
+
+    std::vector<char> symbol(symbol_length);
+    for (auto number = 0u; !async.finished() && number < 4 * input_symbols; ++number)
+    {
+        encoder.generate_symbol(number, symbol.data());
+        async.feed(symbol.data(), number);
+    }
+    ASSERT_TRUE(completed.get_future().get());
+    ASSERT_TRUE(finished);
+    EXPECT_GT(ranges.size(), 1u);
+    std::vector<bool> covered(input_symbols);
+    for (const auto& range : ranges)
+        for (auto idx = range.first; idx < range.first + range.count; ++idx)
+            covered[idx] = true;
+    EXPECT_THAT(covered, Each(true));
+
+    std::unique_ptr<char[]> payload(decoder.decoded_buffer());
+    EXPECT_EQ(memcmp(payload.get(), data.data(), total_data_size), 0);
+}
+
+TEST(AsyncDecoder, CancelOnExecutor)
+{
+    using namespace Codes::Fountain;
+    ThreadPool pool(2);
+    RLF decoder;
+    decoder.set_seed(13);
+    decoder.set_input_data_size(100);
+    decoder.set_symbol_length(10);
+
+    std::promise<bool> completed;
+    auto result = completed.get_future();
+    {
+        AsyncDecoder async(decoder, [&pool](std::function<void()> task) { pool.post(std::move(task)); });
+        wait_completed(async, completed);
+        std::vector<char> symbol(10, 1);
+        EXPECT_FALSE(async.feed(symbol.data(), 0));
+        async.cancel();
+        EXPECT_TRUE(async.finished());
+        EXPECT_FALSE(async.feed(symbol.data(), 1));
+    }
+    EXPECT_FALSE(result.get());
+    EXPECT_EQ(decoder.stats().symbols_received, 1u);
+}
+
+TEST(AsyncDecoder, DestroyedByResumedWaiter)
+{
+    using namespace Codes::Fountain;
+    RLF decoder;
+    decoder.set_seed(13);
+    decoder.set_input_data_size(100);
+    decoder.set_symbol_length(10);
+
+    auto tasks = std::make_shared<size_t>(0);
+    auto async = std::make_unique<AsyncDecoder<RLF>>(decoder, [tasks](std::function<void()> task) {
+        ++*tasks;
+        task();
+    });
+    size_t completions = 0;
+    // first waiter destroys the decoder while the second is still queued
+    release_when_completed(async, completions);
+    std::promise<bool> completed;
+    auto result = completed.get_future();
+    wait_completed(*async, completed);
+    async->cancel();
+    EXPECT_FALSE(async);
+    EXPECT_EQ(completions, 1u);
+    EXPECT_FALSE(result.get());
+    EXPECT_EQ(*tasks, 2u);
+}
+
+TEST(AsyncDecoder, CancelDuringDecodeStaysFinal)
+{
+    using namespace Codes::Fountain;
+    auto symbol_length = 8u;
+    auto input_symbols = 200u;
+    auto total_data_size = symbol_length * input_symbols;
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 5);
+
+    LT encoder(new RobustSolitonDistribution(0.05, 0.03));
+    encoder.set_seed(13);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    BasicLT<CancellingObserver> decoder(new RobustSolitonDistribution(0.05, 0.03));
+    decoder.set_seed(13);
+    decoder.set_input_data_size(total_data_size);
+    decoder.set_symbol_length(symbol_length);
+    AsyncDecoder async(decoder);
+    decoder.observer().cancel = [&async] { async.cancel(); };
+
+    std::promise<bool> completed;
+    std::vector<DecodedRange> ranges;
+    bool finished = false;
+    wait_completed(async, completed);
+    collect_ranges(async, ranges, finished);
+
+    std::vector<char> symbols(3 * total_data_size);
+    std::vector<SymbolPacket> batch;
+    for (auto number = 0u; number < 3 * input_symbols; ++number)
+    {
+        encoder.generate_symbol(number, symbols.data() + number * symbol_length);
+        batch.push_back({symbols.data() + number * symbol_length, number});
+    }
+    // decoding completes after it was cancelled, waiters already saw false
+    async.feed(batch);
+    EXPECT_EQ(decoder.decoded_prefix(), input_symbols);
+    EXPECT_FALSE(completed.get_future().get());
+    EXPECT_TRUE(finished);
+    EXPECT_TRUE(ranges.empty());
+    EXPECT_TRUE(async.finished());
+    EXPECT_FALSE(async.is_decoded());
+
+    // later waiters see the cancel too
+    std::promise<bool> late;
+    wait_completed(async, late);
+    EXPECT_FALSE(late.get_future().get());
+}
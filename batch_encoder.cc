@@ -0,0 +1,95 @@
+#include "batch_encoder.h"
+#include "code_graph.h"
+#include "lt.h"
+#include "rlf.h"
+#include "robust_soliton_distribution.h"
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+
+using namespace testing;
+
+namespace {
+std::vector<std::vector<char>> make_messages(size_t messages, size_t size)
+{
+    std::vector<std::vector<char>> result(messages, std::vector<char>(size));
+    for (auto message = 0u; message < messages; ++message)
+        for (auto idx = 0u; idx < size; ++idx)
+            result[message][idx] = static_cast<char>(idx * 7 + message * 13);
+    return result;
+}
+} // namespace
+
+TEST(BatchEncoder, MatchesLTPerMessage)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto symbol_length = 8u;
+    auto input_symbols = 100u;
+    auto messages = 16u;
+    auto symbols = 150u;
+    auto seed = 13u;
+    auto data = make_messages(messages, symbol_length * input_symbols);
+    std::vector<const char*> pointers;
+    for (const auto& message : data)
+        pointers.push_back(message.data());
+
+    auto graph = CodeGraph::build_lt(new RobustSolitonDistribution(0.05, 0.03), seed, input_symbols, symbols);
+    BatchEncoder batch(graph, messages, symbol_length);
+    std::vector<char> interleaved(messages * symbol_length * input_symbols);
+    BatchEncoder::interleave(pointers, input_symbols, symbol_length, interleaved.data());
+    batch.set_input_data(interleaved.data());
+
+    std::vector<char> block(batch.block_size());
+    std::vector<char> expected(symbol_length);
+    for (auto message = 0u; message < messages; ++message)
+    {
+        LT encoder(new RobustSolitonDistribution(0.05, 0.03));
+        encoder.set_seed(seed);
+        encoder.set_input_data(data[message].data(), data[message].size());
+        encoder.set_symbol_length(symbol_length);
+        for (auto number = 0u; number < symbols; ++number)
+        {
+            ASSERT_TRUE(batch.generate_symbol(number, block.data()));
+            encoder.generate_symbol(number, expected.data());
+            ASSERT_EQ(memcmp(block.data() + message * symbol_length, expected.data(), symbol_length), 0);
+        }
+    }
+    EXPECT_FALSE(batch.generate_symbol(symbols, block.data()));
+}
+
+TEST(BatchEncoder, MatchesRLFPerMessage)
+{
+    using namespace Codes::Fountain;
+    auto symbol_length = 4u;
+    auto input_symbols = 70u;
+    auto messages = 5u;
+    auto symbols = 90u;
+    auto seed = 7u;
+    auto data = make_messages(messages, symbol_length * input_symbols);
+    std::vector<const char*> pointers;
+    for (const auto& message : data)
+        pointers.push_back(message.data());
+
+    BatchEncoder batch(CodeGraph::build_rlf(seed, input_symbols, symbols), messages, symbol_length);
+    std::vector<char> interleaved(messages * symbol_length * input_symbols);
+    BatchEncoder::interleave(pointers, input_symbols, symbol_length, interleaved.data());
+    batch.set_input_data(interleaved.data());
+
+    std::vector<char> block(batch.block_size());
+    std::vector<char> expected(symbol_length);
+    for (auto message = 0u; message < messages; ++message)
+    {
+        RLF encoder;
+        encoder.set_seed(seed);
+        encoder.set_input_data(data[message].data(), data[message].size());
+        encoder.set_symbol_length(symbol_length);
+        for (auto number = 0u; number < symbols; ++number)
+        {
+            ASSERT_TRUE(batch.generate_symbol(number, block.data()));
+            encoder.generate_symbol(number, expected.data());
+            ASSERT_EQ(memcmp(block.data() + message * symbol_length, expected.data(), symbol_length), 0);
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#include "capped_distribution.h"
+#include "lt.h"
+#include "robust_soliton_distribution.h"
+
+#include <numeric>
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+
+using namespace testing;
+
+TEST(CappedDistribution, RenormalisedBelowCap)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto input_symbols = 256u;
+    auto cap = 16u;
+    auto full = RobustSolitonDistribution(0.05, 0.03).expected_distribution(input_symbols);
+    CappedDistribution capped(new RobustSolitonDistribution(0.05, 0.03), cap);
+    auto expected = capped.expected_distribution(input_symbols);
+
+    ASSERT_EQ(expected.size(), input_symbols);
+    EXPECT_THAT(std::accumulate(expected.begin(), expected.end(), 0.0), DoubleNear(1.0, 1e-9));
+    EXPECT_THAT(std::vector<double>(expected.begin() + cap, expected.end()), Each(0.0));
+    EXPECT_THAT(expected[1] / expected[0], DoubleNear(full[1] / full[0], 1e-9));
+    EXPECT_EQ(capped.key(), "capped:16:" + RobustSolitonDistribution(0.05, 0.03).key());
+
+    capped.set_seed(13);
+    capped.set_input_size(input_symbols);
+    size_t max_degree = 0;
+    for (auto idx = 0; idx < 10000; ++idx)
+        max_degree = std::max(max_degree, capped.symbol_degree());
+    EXPECT_EQ(max_degree, cap);
+}
+
+TEST(CappedDistribution, BoundsEncoderXors)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto symbol_length = 4u;
+    auto input_symbols = 128u;
+    auto cap = 8u;
+    std::vector<char> data(symbol_length * input_symbols);
+    std::vector<char> symbol(symbol_length);
+
+    LT encoder(new CappedDistribution(new RobustSolitonDistribution(0.05, 0.03), cap));
+    encoder.set_seed(13);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+    size_t max_degree = 0;
+    for (auto number = 0u; number < 2000; ++number)
+    {
+        encoder.generate_symbol(number, symbol.data());
+        max_degree = std::max(max_degree, encoder._current_hash_bits.size());
+    }
+    EXPECT_EQ(max_degree, cap);
+}
+
+TEST(CappedDistribution, CapImpact)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    SeedSearch::Options options;
+    options.threads = 4;
+    auto impact = cap_impact([] { return new RobustSolitonDistribution(0.05, 0.03); }, 256, {0, 128, 8}, 50, options);
+    ASSERT_EQ(impact.size(), 3u);
+    EXPECT_EQ(impact[0].max_degree, 0u);
+    EXPECT_GT(impact[0].mean_degree, impact[1].mean_degree);
+    EXPECT_GT(impact[1].mean_degree, impact[2].mean_degree);
+    // cutting above the spike of robust soliton keeps it decodable, cutting
+    // below it does not
+    EXPECT_EQ(impact[1].failures, 0u);
+    EXPECT_GT(impact[2].failures, impact[1].failures);
+}
@@ -0,0 +1,114 @@
+#include "crc32c.h"
+#include "lt.h"
+#include "rlf.h"
+#include "robust_soliton_distribution.h"
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+
+using namespace testing;
+
+TEST(Crc32c, KnownValues)
+{
+    using namespace Codes::Fountain;
+    spdlog::debug("crc32c hardware: {}", crc32c_hardware());
+    EXPECT_EQ(crc32c("123456789", 9), 0xE3069283u);
+    EXPECT_EQ(crc32c("", 0), 0u);
+
+    std::vector<char> data(1000);
+    for (auto idx = 0u; idx < data.size(); ++idx)
+        data[idx] = static_cast<char>(idx * 13 + 1);
+    for (auto split : {0u, 1u, 7u, 8u, 333u, 1000u})
+        EXPECT_EQ(crc32c(data.data() + split, data.size() - split, crc32c(data.data(), split)),
+                  crc32c(data.data(), data.size()));
+
+    std::vector<uint32_t> tags(10);
+    symbol_tags(data.data(), tags.size(), 100, 40, tags.data());
+    for (auto idx = 0u; idx < tags.size(); ++idx)
+        EXPECT_EQ(tags[idx], symbol_tag(data.data() + idx * 100, 100, 40 + idx));
+    EXPECT_NE(symbol_tag(data.data(), 100, 0), symbol_tag(data.data(), 100, 1));
+}
+
+TEST(Crc32c, LTRejectsCorruptedSymbols)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto symbol_length = 16u;
+    auto input_symbols = 300u;
+    auto total_data_size = symbol_length * input_symbols;
+    auto seed = 13u;
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 7 + 3);
+
+    LT encoder(new RobustSolitonDistribution(0.05, 0.03));
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    LT decoder(new RobustSolitonDistribution(0.05, 0.03));
+    decoder.set_seed(seed);
+    decoder.set_input_data_size(total_data_size);
+    decoder.set_symbol_length(symbol_length);
+
+    // every 10th symbol gets a bit flipped on the way
+    std::vector<char> symbol(symbol_length);
+    auto corrupted = 0u;
+    auto decoded = false;
+    for (auto number = 0u; !decoded && number < 4 * input_symbols; ++number)
+    {
+        encoder.generate_symbol(number, symbol.data());
+        auto tag = symbol_tag(symbol.data(), symbol_length, number);
+        if (number % 10 == 4)
+        {
+            symbol[number % symbol_length] ^= 0x10;
+            ++corrupted;
+        }
+        EXPECT_EQ(decoder.feed_tagged_symbol(symbol.data(), number, tag), number % 10 != 4);
+        decoded = decoder.decode();
+    }
+    ASSERT_TRUE(decoded);
+    EXPECT_EQ(decoder.stats().corrupted_symbols, corrupted);
+    std::unique_ptr<char[]> payload(decoder.decoded_buffer());
+    ASSERT_EQ(memcmp(payload.get(), data.data(), total_data_size), 0);
+}
+
+TEST(Crc32c, RLFRejectsCorruptedSymbols)
+{
+    using namespace Codes::Fountain;
+    auto symbol_length = 8u;
+    auto input_symbols = 100u;
+    auto total_data_size = symbol_length * input_symbols;
+    auto seed = 13u;
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 5 + 1);
+
+    RLF encoder;
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    RLF decoder;
+    decoder.set_seed(seed);
+    decoder.set_input_data_size(total_data_size);
+    decoder.set_symbol_length(symbol_length);
+
+    std::vector<char> symbol(symbol_length);
+    auto decoded = false;
+    for (auto number = 0u; !decoded && number < 2 * input_symbols; ++number)
+    {
+        encoder.generate_symbol(number, symbol.data());
+        auto tag = symbol_tag(symbol.data(), symbol_length, number);
+        // a symbol fed under the wrong number is caught as well
+        EXPECT_FALSE(decoder.feed_tagged_symbol(symbol.data(), number + 1, tag, true));
+        if (number % 4 == 1)
+            symbol[0] ^= 1;
+        EXPECT_EQ(decoder.feed_tagged_symbol(symbol.data(), number, tag, true), number % 4 != 1);
+        decoded = decoder.decode();
+    }
+    ASSERT_TRUE(decoded);
+    std::unique_ptr<char[]> payload(decoder.decoded_buffer());
+    ASSERT_EQ(memcmp(payload.get(), data.data(), total_data_size), 0);
+}
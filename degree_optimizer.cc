@@ -0,0 +1,96 @@
+#include "degree_optimizer.h"
+#include "lt.h"
+#include "tabulated_distribution.h"
+
+#include <filesystem>
+#include <numeric>
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+
+using namespace testing;
+
+TEST(TabulatedDistribution, SaveLoadAndFold)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    TabulatedDistribution distribution({1.0, 2.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 1.0});
+    EXPECT_THAT(distribution.probabilities()[1], DoubleEq(0.5));
+    // degree 10 does not fit K = 4 and is folded into degree 4
+    EXPECT_THAT(distribution.expected_distribution(4), ElementsAre(DoubleEq(0.25), DoubleEq(0.5), 0.0, DoubleEq(0.25)));
+
+    auto path = (std::filesystem::temp_directory_path() / "rateless_codes_tabulated.txt").string();
+    ASSERT_TRUE(distribution.save(path));
+    auto loaded = TabulatedDistribution::load(path);
+    ASSERT_TRUE(loaded);
+    EXPECT_EQ(loaded->key(), distribution.key());
+    EXPECT_FALSE(TabulatedDistribution::load(path + ".missing"));
+
+    loaded->set_seed(13);
+    loaded->set_input_size(4);
+    std::vector<size_t> counts(5);
+    for (auto idx = 0; idx < 4000; ++idx)
+        ++counts[loaded->symbol_degree()];
+    EXPECT_EQ(counts[0], 0u);
+    EXPECT_EQ(counts[3], 0u);
+    EXPECT_NEAR(static_cast<double>(counts[2]) / 4000.0, 0.5, 0.05);
+}
+
+TEST(TabulatedDistribution, FoldedForSmallBlocks)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto symbol_length = 4u;
+    auto input_symbols = 6u;
+    std::vector<char> data(symbol_length * input_symbols);
+    std::vector<char> symbol(symbol_length);
+
+    // degree 8 does not fit K = 6, its symbols cover the whole block
+    LT encoder(new TabulatedDistribution({0.1, 0.5, 0.2, 0.1, 0.0, 0.0, 0.0, 0.1}));
+    encoder.set_seed(13);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+    std::vector<size_t> counts(input_symbols + 1);
+    for (auto number = 0u; number < 2000; ++number)
+    {
+        encoder.generate_symbol(number, symbol.data());
+        ++counts[encoder._current_hash_bits.size()];
+    }
+    EXPECT_EQ(counts[0], 0u);
+    EXPECT_EQ(counts[5], 0u);
+    EXPECT_NEAR(static_cast<double>(counts[6]) / 2000.0, 0.1, 0.03);
+    EXPECT_NEAR(static_cast<double>(counts[2]) / 2000.0, 0.5, 0.05);
+}
+
+TEST(DegreeOptimizer, ImprovesOnStart)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    DegreeOptimizer::Options options;
+    options.samples = 64;
+    options.iterations = 0;
+    options.threads = 4;
+    options.support = {2, 3, 4, 8, 16};
+    auto start = DegreeOptimizer::optimize(32, options);
+    options.iterations = 40;
+    auto result = DegreeOptimizer::optimize(32, options);
+
+    EXPECT_LE(result.mean_overhead, start.mean_overhead);
+    EXPECT_GT(result.accepted, 0u);
+    // degree 1 is always part of the support
+    ASSERT_EQ(result.probabilities.size(), 16u);
+    EXPECT_THAT(std::accumulate(result.probabilities.begin(), result.probabilities.end(), 0.0), DoubleNear(1.0, 1e-9));
+    for (auto degree : {5u, 6u, 7u, 9u, 15u})
+        EXPECT_EQ(result.probabilities[degree - 1], 0.0);
+
+    // the result scores the same when loaded as a distribution
+    auto overhead = DegreeOptimizer::mean_overhead(
+        [&] { return new TabulatedDistribution(result.probabilities); }, 32, 1, options.samples, options);
+    EXPECT_THAT(overhead, DoubleEq(result.mean_overhead));
+
+    // no support degree fits, nothing is evaluated
+    auto empty = DegreeOptimizer::optimize(0, options);
+    EXPECT_TRUE(empty.probabilities.empty());
+    EXPECT_EQ(empty.accepted, 0u);
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Codes::Fountain::Archive {
+
+// Erasure coded archive. The input is cut into source blocks of
+// block_symbols symbols (the last one zero padded), every block is encoded
+// with a systematic RLF into block_symbols + repair_symbols symbols and
+// symbol j of a block goes to shard j % shards. Shard i is the file
+// <directory>/<name>.<i>.shard with directory = directories[i % size], laid
+// out as a 64 byte header followed by fixed size records (payload + u32
+// symbol_tag()), every block taking the same number of slots per shard.
+// Any block_symbols intact symbols of a block (plus a few for the rank)
+// restore it, whole shards may be lost, truncated or corrupted.
+inline constexpr uint32_t magic = 0x52414352; // "RCAR"
+inline constexpr uint32_t version = 1;
+inline constexpr size_t header_size = 64;
+
+struct Header
+{
+    uint32_t magic = Archive::magic;
+    uint32_t version = Archive::version;
+    uint32_t shard = 0;
+    uint32_t shards = 0;
+    uint32_t seed = 0;
+    uint32_t padding = 0;
+    uint64_t file_size = 0;
+    uint64_t symbol_length = 0;
+    uint64_t block_symbols = 0;
+    uint64_t repair_symbols = 0;
+    uint64_t reserved = 0;
+};
+static_assert(sizeof(Header) == header_size);
+
+struct Options
+{
+    size_t symbol_length = 4096;
+    size_t block_symbols = 256;
+    size_t repair_symbols = 128;
+    // 0 means one shard per directory
+    size_t shards = 0;
+    uint32_t seed = 0;
+};
+
+std::string shard_path(const std::string& directory, const std::string& name, size_t shard);
+
+// Shard reads and writes are batched through AsyncFileIo, the next block is
+// read while the current one is coded and the previous one is written.
+bool encode(const std::string& input, const std::string& name, const std::vector<std::string>& directories,
+            const Options& options = {});
+// Every directory is searched for every shard, so shards may be moved
+// around between encode and decode. A shard that fails to read is left out
+// of that block. Output is written to <output>.partial and renamed over
+// output once complete.
+bool decode(const std::string& name, const std::vector<std::string>& directories, const std::string& output);
+} // namespace Codes::Fountain::Archive
@@ -0,0 +1,262 @@
+#pragma once
+
+#include <algorithm>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "codec_feed.h"
+
+namespace Codes::Fountain {
+
+// Contiguous run of recovered input symbols
+struct DecodedRange
+{
+    size_t first = 0;
+    size_t count = 0;
+};
+
+// Runs a task somewhere, awaiting coroutines are resumed through it
+using Executor = std::function<void(std::function<void()>)>;
+
+inline void inline_executor(std::function<void()> task)
+{
+    task();
+}
+
+// Coroutine front end for a decoder. Symbols are fed from the I/O side,
+// coroutines wait with
+//   co_await decoder.completed()          - true once decoded, false if cancelled
+//   while (auto range = co_await decoder.next_range())
+// Ranges are reported as inputs are recovered when the codec observer is a
+// ProgressObserver, otherwise as one range once decoding completes.
+// next_range() expects a single consumer. Waiters never touch the decoder
+// after being resumed, so it may be destroyed from a resumed coroutine.
+template <typename Codec>
+class AsyncDecoder
+{
+    enum class State
+    {
+        Running,
+        Decoded,
+        Cancelled
+    };
+
+public:
+    class CompletionAwaiter
+    {
+    public:
+        explicit CompletionAwaiter(AsyncDecoder& decoder)
+            : _decoder(decoder)
+        {}
+
+        bool await_ready() const
+        {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            std::lock_guard lock(_decoder._mutex);
+            if (_decoder._state != State::Running)
+            {
+                _result = _decoder._state == State::Decoded;
+                return false;
+            }
+            _handle = handle;
+            _decoder._completion_waiters.push_back(this);
+            return true;
+        }
+
+        bool await_resume() const
+        {
+            return _result;
+        }
+
+    private:
+        friend class AsyncDecoder;
+        AsyncDecoder& _decoder;
+        std::coroutine_handle<> _handle;
+        bool _result = false;
+    };
+
+    class RangeAwaiter
+    {
+    public:
+        explicit RangeAwaiter(AsyncDecoder& decoder)
+            : _decoder(decoder)
+        {}
+
+        bool await_ready() const
+        {
+            return false;
+        }
+
+        bool await_suspend(std::coroutine_handle<> handle)
+        {
+            std::lock_guard lock(_decoder._mutex);
+            if (!_decoder._ranges.empty())
+            {
+                _result = _decoder._ranges.front();
+                _decoder._ranges.pop_front();
+                return false;
+            }
+            if (_decoder._state != State::Running)
+                return false;
+            _handle = handle;
+            _decoder._range_waiters.push_back(this);
+            return true;
+        }
+
+        std::optional<DecodedRange> await_resume() const
+        {
+            return _result;
+        }
+
+    private:
+        friend class AsyncDecoder;
+        AsyncDecoder& _decoder;
+        std::coroutine_handle<> _handle;
+        std::optional<DecodedRange> _result;
+    };
+
+    explicit AsyncDecoder(Codec& codec, Executor executor = inline_executor)
+        : _codec(codec)
+        , _executor(std::move(executor))
+    {}
+
+    ~AsyncDecoder()
+    {
+        cancel();
+    }
+
+    // Returns true once decoded, symbols after completion or cancel are ignored
+    bool feed(char* ptr, size_t number)
+    {
+        if (finished())
+            return is_decoded();
+        feed_postponed(_codec, ptr, number, Memory::MakeCopy);
+        auto decoded = _codec.decode();
+        publish(decoded);
+        return decoded;
+    }
+
+    bool feed(std::span<SymbolPacket> packets)
+    {
+        if (finished())
+            return is_decoded();
+        auto decoded = feed_batch(_codec, packets);
+        publish(decoded);
+        return decoded;
+    }
+
+    // Wakes every waiter, completion resolves to false and ranges end
+    void cancel()
+    {
+        std::unique_lock lock(_mutex);
+        if (_state != State::Running)
+            return;
+        _state = State::Cancelled;
+        _ranges.clear();
+        resume(lock);
+    }
+
+    bool finished() const
+    {
+        std::lock_guard lock(_mutex);
+        return _state != State::Running;
+    }
+
+    bool is_decoded() const
+    {
+        std::lock_guard lock(_mutex);
+        return _state == State::Decoded;
+    }
+
+    CompletionAwaiter completed()
+    {
+        return CompletionAwaiter(*this);
+    }
+
+    RangeAwaiter next_range()
+    {
+        return RangeAwaiter(*this);
+    }
+
+private:
+    void publish(bool decoded)
+    {
+        std::vector<DecodedRange> ranges;
+        if constexpr (requires { _codec.observer().take(); })
+        {
+            auto inputs = _codec.observer().take();
+            std::sort(inputs.begin(), inputs.end());
+            for (auto input : inputs)
+            {
+                if (!ranges.empty() && ranges.back().first + ranges.back().count == input)
+                    ++ranges.back().count;
+                else
+                    ranges.push_back({input, 1});
+            }
+        }
+        else if (decoded)
+            ranges.push_back({0, _codec._input_symbols});
+
+        std::unique_lock lock(_mutex);
+        // a cancel() that raced with decoding stays final
+        if (_state != State::Running)
+            return;
+        _ranges.insert(_ranges.end(), ranges.begin(), ranges.end());
+        if (decoded)
+            _state = State::Decoded;
+        resume(lock);
+    }
+
+    // Hands results to waiters under lock, resumes them through the executor
+    void resume(std::unique_lock<std::mutex>& lock)
+    {
+        std::vector<std::coroutine_handle<>> handles;
+        while (!_range_waiters.empty() && (!_ranges.empty() || _state != State::Running))
+        {
+            auto* waiter = _range_waiters.front();
+            _range_waiters.pop_front();
+            if (!_ranges.empty())
+            {
+                waiter->_result = _ranges.front();
+                _ranges.pop_front();
+            }
+            handles.push_back(waiter->_handle);
+        }
+        if (_state != State::Running)
+        {
+            for (auto* waiter : _completion_waiters)
+            {
+                waiter->_result = _state == State::Decoded;
+                handles.push_back(waiter->_handle);
+            }
+            _completion_waiters.clear();
+        }
+        if (handles.empty())
+            return;
+        // a resumed coroutine may destroy the decoder, only locals are used
+        // from here on
+        auto executor = _executor;
+        lock.unlock();
+        for (auto handle : handles)
+            executor([handle] { handle.resume(); });
+    }
+
+    Codec& _codec;
+    Executor _executor;
+    mutable std::mutex _mutex;
+    State _state = State::Running;
+    std::deque<DecodedRange> _ranges;
+    std::vector<CompletionAwaiter*> _completion_waiters;
+    std::deque<RangeAwaiter*> _range_waiters;
+};
+} // namespace Codes::Fountain
\ No newline at end of file
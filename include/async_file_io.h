@@ -0,0 +1,90 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <sys/uio.h>
+
+namespace Codes::Fountain {
+
+class ThreadPool;
+
+// Batched positional file I/O on raw descriptors. On Linux requests go to an
+// io_uring instance driven through plain syscalls (no liburing needed),
+// where io_uring is unavailable they run as pread/pwrite on a thread pool.
+// Buffers have to stay valid until wait() returns. read() and write() return
+// the request id, ids start from 0 again after every wait(). use_uring false
+// forces the thread pool.
+class AsyncFileIo
+{
+public:
+    explicit AsyncFileIo(unsigned depth = 64, bool use_uring = true);
+    ~AsyncFileIo();
+    AsyncFileIo(const AsyncFileIo&) = delete;
+    AsyncFileIo& operator=(const AsyncFileIo&) = delete;
+
+    bool uses_uring() const;
+    size_t read(int fd, char* buffer, size_t len, uint64_t offset);
+    size_t write(int fd, const char* buffer, size_t len, uint64_t offset);
+    // Starts queued requests without waiting for them
+    void submit();
+    // Waits for every request, false if any of them failed or was short
+    bool wait();
+    // Ids of the requests the last wait() found failed or short, ascending
+    const std::vector<size_t>& failed() const;
+
+private:
+    struct Request
+    {
+        int fd = -1;
+        iovec io{};
+        uint64_t offset = 0;
+        bool write = false;
+        // completion was seen on the ring
+        bool reaped = false;
+    };
+
+    bool setup_uring(unsigned depth);
+    bool submit_uring(size_t id);
+    void reap_uring(unsigned min_complete);
+    bool enter(unsigned min_complete, unsigned flags);
+    void drop_uring();
+    void close_uring();
+    void run(size_t id, const Request& request);
+
+    std::deque<Request> _requests;
+    size_t _submitted = 0;
+    std::vector<size_t> _failing;
+    std::vector<size_t> _failed;
+
+    // io_uring rings, mapped from the kernel
+    int _ring = -1;
+    unsigned _entries = 0;
+    size_t _in_flight = 0;
+    size_t _pending_submit = 0;
+    void* _sq_map = nullptr;
+    size_t _sq_map_size = 0;
+    void* _cq_map = nullptr;
+    size_t _cq_map_size = 0;
+    void* _sqes = nullptr;
+    size_t _sqes_size = 0;
+    unsigned* _sq_tail = nullptr;
+    unsigned* _sq_mask = nullptr;
+    unsigned* _sq_array = nullptr;
+    unsigned* _cq_head = nullptr;
+    unsigned* _cq_tail = nullptr;
+    unsigned* _cq_mask = nullptr;
+    void* _cqes = nullptr;
+
+    // fallback
+    std::unique_ptr<ThreadPool> _pool;
+    std::mutex _mutex;
+    std::condition_variable _done;
+    size_t _running = 0;
+};
+} // namespace Codes::Fountain
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+
+#include "xor_kernel.h"
+
+namespace Codes::Fountain {
+
+class CodeGraph;
+
+// Encodes M messages of the same shape (K, symbol length, seed) with one
+// shared schedule. Input is struct of arrays: symbol i of message m lives
+// at data + (i * M + m) * symbol_length, so symbol i of every message is a
+// single block of M * symbol_length bytes. An encoded symbol then costs one
+// XOR over that block per neighbour, and the schedule (PRNG, degree and
+// neighbour sampling) is paid once for all messages. Output symbols use the
+// same layout, message m at out + m * symbol_length.
+class BatchEncoder
+{
+public:
+    BatchEncoder(std::shared_ptr<const CodeGraph> graph, size_t messages, size_t symbol_length);
+
+    // Interleaves M separate messages of K symbols into the batch layout
+    static void interleave(std::span<const char* const> messages, size_t input_symbols, size_t symbol_length,
+                           char* out);
+
+    void set_input_data(const char* ptr);
+    size_t messages() const;
+    size_t block_size() const;
+    // Returns false for symbols not covered by the graph
+    bool generate_symbol(size_t number, char* out);
+
+private:
+    std::shared_ptr<const CodeGraph> _graph;
+    size_t _messages = 0;
+    size_t _symbol_length = 0;
+    size_t _block_size = 0;
+    XorKernel _xor = xor_generic;
+    const char* _input_data = nullptr;
+};
+} // namespace Codes::Fountain
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "degree_distribution.h"
+#include "seed_search.h"
+#include "well512.h"
+
+namespace Codes::Fountain {
+// Limits symbol degree to max_degree, so no symbol costs more than
+// max_degree XORs to encode. Probabilities of the wrapped distribution above
+// the cap are dropped and the rest is renormalised. Takes ownership of
+// distribution, same as LT constructor.
+class CappedDistribution : public DegreeDistribution
+{
+public:
+    CappedDistribution(DegreeDistribution* distribution, size_t max_degree);
+    virtual ~CappedDistribution() = default;
+
+    size_t max_degree() const;
+
+    void set_seed(uint32_t seed) override;
+    void set_input_size(size_t input_symbols) override;
+    size_t symbol_degree() override;
+    std::vector<double> expected_distribution(size_t input_symbols) override;
+    std::string key() const override;
+
+private:
+    std::unique_ptr<DegreeDistribution> _distribution;
+    size_t _max_degree = 0;
+    well_512 _degree_dist;
+    std::vector<double> _cumulative_probabilities;
+};
+
+struct CapImpact
+{
+    // 0 is the wrapped distribution without a cap
+    size_t max_degree = 0;
+    // Expected XORs per generated symbol
+    double mean_degree = 0.0;
+    double mean_overhead = 0.0;
+    size_t worst_overhead = 0;
+    // Seeds that did not decode within K + options.max_overhead symbols
+    size_t failures = 0;
+};
+
+// Loss free LT overhead over seeds [1, 1 + samples) for every cap, using the
+// index only simulation of SeedSearch
+std::vector<CapImpact> cap_impact(const SeedSearch::DistributionFactory& distribution, size_t input_symbols,
+                                  const std::vector<size_t>& caps, size_t samples,
+                                  const SeedSearch::Options& options = {});
+} // namespace Codes::Fountain
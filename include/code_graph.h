@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "degree_distribution.h"
+#include "prng.h"
+
+namespace Codes::Fountain {
+
+// Immutable encoding schedule for symbol ids [0, symbols()). LT graphs keep
+// neighbor lists, RLF graphs keep packed coefficient rows. Codecs using a
+// graph skip the generator for covered ids, so one graph can be shared by
+// any number of encoders and decoders with the same seed and shape.
+class CodeGraph
+{
+public:
+    // Spelled differently from the codec classes, so they are not shadowed
+    enum class Kind
+    {
+        Lt,
+        Rlf
+    };
+
+    // Takes ownership of distribution, same as LT constructor
+    static std::shared_ptr<const CodeGraph> build_lt(DegreeDistribution* distribution, uint32_t seed,
+                                                     size_t input_symbols, size_t symbols,
+                                                     PrngType type = PrngType::Well512);
+    static std::shared_ptr<const CodeGraph> build_rlf(uint32_t seed, size_t input_symbols, size_t symbols,
+                                                      PrngType type = PrngType::Well512);
+
+    Kind kind() const;
+    uint32_t seed() const;
+    PrngType generator() const;
+    // Distribution key of an LT graph, empty for RLF
+    const std::string& distribution() const;
+    size_t symbols() const;
+    size_t input_symbols() const;
+    // Graph describes a codec with this seed, K and generator
+    bool matches(uint32_t seed, size_t input_symbols, PrngType type) const;
+    std::span<const uint32_t> neighbors(size_t symbol) const;
+    const uint64_t* row(size_t symbol) const;
+    size_t row_words() const;
+
+private:
+    Kind _kind = Kind::Lt;
+    uint32_t _seed = 0;
+    PrngType _generator = PrngType::Well512;
+    std::string _distribution;
+    size_t _symbols = 0;
+    size_t _input_symbols = 0;
+    size_t _row_words = 0;
+    std::vector<size_t> _offsets;
+    std::vector<uint32_t> _neighbors;
+    std::vector<uint64_t> _rows;
+};
+
+// Process wide cache of graphs keyed by (kind, seed, K, symbols, distribution, generator).
+// Graphs are built outside the cache lock, concurrent requests for the same
+// key wait for a single build. Past capacity the least recently requested
+// graph is dropped, codecs holding it keep their copy. A distribution
+// without its own key() gets a fresh graph on every call.
+class CodeGraphCache
+{
+public:
+    static CodeGraphCache& instance();
+
+    std::shared_ptr<const CodeGraph> lt(DegreeDistribution* distribution, uint32_t seed, size_t input_symbols,
+                                        size_t symbols, PrngType type = PrngType::Well512);
+    std::shared_ptr<const CodeGraph> rlf(uint32_t seed, size_t input_symbols, size_t symbols,
+                                         PrngType type = PrngType::Well512);
+    size_t size() const;
+    size_t capacity() const;
+    void set_capacity(size_t capacity);
+    void clear();
+
+private:
+    using Key = std::tuple<CodeGraph::Kind, uint32_t, size_t, size_t, std::string, PrngType>;
+
+    struct Entry
+    {
+        std::once_flag built;
+        std::shared_ptr<const CodeGraph> graph;
+        uint64_t last_used = 0;
+    };
+
+    std::shared_ptr<Entry> entry(const Key& key);
+    void evict();
+
+    mutable std::mutex _mutex;
+    std::map<Key, std::shared_ptr<Entry>> _graphs;
+    size_t _capacity = 64;
+    uint64_t _requests = 0;
+};
+
+inline size_t CodeGraph::symbols() const
+{
+    return _symbols;
+}
+
+inline std::span<const uint32_t> CodeGraph::neighbors(size_t symbol) const
+{
+    return std::span(_neighbors.data() + _offsets[symbol], _offsets[symbol + 1] - _offsets[symbol]);
+}
+
+inline const uint64_t* CodeGraph::row(size_t symbol) const
+{
+    return _rows.data() + symbol * _row_words;
+}
+
+inline bool CodeGraph::matches(uint32_t seed, size_t input_symbols, PrngType type) const
+{
+    return _seed == seed && _input_symbols == input_symbols && _generator == type;
+}
+} // namespace Codes::Fountain
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <span>
+#include <type_traits>
+
+#include "lt.h"
+#include "rlf.h"
+#include "symbol_packet.h"
+
+namespace Codes::Fountain {
+
+// Codec independent feeding for the drivers (ingestor, scheduler, async
+// decoder). RLF takes a deep copy flag and never owns caller memory, LT
+// takes Memory and can adopt the buffer.
+
+// Queues one symbol with decoding postponed. An Owner buffer handed to RLF
+// is copied and freed at once.
+template <typename Codec>
+void feed_postponed(Codec& codec, char* ptr, size_t number, Memory mem)
+{
+    if constexpr (std::is_same_v<Codec, RLF>)
+    {
+        codec.feed_symbol(ptr, number, true);
+        if (mem == Memory::Owner)
+            delete[] ptr;
+    }
+    else
+        codec.feed_symbol(ptr, number, mem, Decoding::Postpone);
+}
+
+// Copies a batch the caller keeps into the codec and runs one decode pass
+template <typename Codec>
+bool feed_batch(Codec& codec, std::span<SymbolPacket> packets)
+{
+    if constexpr (std::is_same_v<Codec, RLF>)
+        return codec.feed_symbols(packets, true);
+    else
+        return codec.feed_symbols(packets, Memory::MakeCopy);
+}
+} // namespace Codes::Fountain
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Codes::Fountain {
+
+// CRC32C (Castagnoli), crc of a previous call continues the checksum. Uses
+// the SSE4.2 crc32 instruction when the CPU has it, a table otherwise.
+uint32_t crc32c(const char* data, size_t len, uint32_t crc = 0);
+bool crc32c_hardware();
+
+// Integrity tag of one encoded symbol. The symbol number is covered too, so
+// a symbol fed under a wrong number is rejected as well.
+uint32_t symbol_tag(const char* data, size_t symbol_length, size_t number);
+// Tags of count consecutive symbols stored back to back, first one numbered first
+void symbol_tags(const char* symbols, size_t count, size_t symbol_length, size_t first, uint32_t* tags);
+} // namespace Codes::Fountain
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace Codes::Fountain {
+
+enum class DecoderEventType : uint8_t
+{
+    SymbolFed,
+    SymbolReleased,
+    InputDecoded,
+    RippleEmpty
+};
+
+struct DecoderEvent
+{
+    DecoderEventType type;
+    uint64_t symbol;
+    uint64_t value;
+};
+
+// Observers receive decoder events through plain member calls, so an
+// observer with empty inline members compiles to nothing.
+//   symbol_fed(number, degree)         - degree left after reducing by known inputs
+//   symbol_released(encoded, input)    - degree one symbol released into input
+//   input_decoded(input, unknown)      - input recovered, unknown inputs left
+//   ripple_empty(unknown)              - decoding stalled waiting for symbols
+// An optional clear() member is called when the decoder is reset.
+struct NullObserver
+{
+    void symbol_fed(size_t, size_t) {}
+    void symbol_released(size_t, size_t) {}
+    void input_decoded(size_t, size_t) {}
+    void ripple_empty(size_t) {}
+};
+
+// Fixed size binary event capture, oldest events are overwritten
+class RingBufferObserver
+{
+public:
+    explicit RingBufferObserver(size_t capacity = 4096);
+
+    void symbol_fed(size_t number, size_t degree);
+    void symbol_released(size_t encoded, size_t input);
+    void input_decoded(size_t input, size_t unknown);
+    void ripple_empty(size_t unknown);
+
+    void resize(size_t capacity);
+    void clear();
+    size_t size() const;
+    uint64_t total() const;
+    std::vector<DecoderEvent> events() const;
+
+private:
+    void push(DecoderEventType type, size_t symbol, size_t value);
+
+    std::vector<DecoderEvent> _events;
+    size_t _mask = 0;
+    uint64_t _head = 0;
+};
+
+// Logs every event with spdlog at trace level
+struct TraceObserver
+{
+    void symbol_fed(size_t number, size_t degree);
+    void symbol_released(size_t encoded, size_t input);
+    void input_decoded(size_t input, size_t unknown);
+    void ripple_empty(size_t unknown);
+};
+
+// Collects recovered inputs until taken, used for progress reporting
+class ProgressObserver
+{
+public:
+    void symbol_fed(size_t, size_t) {}
+    void symbol_released(size_t, size_t) {}
+    void input_decoded(size_t input, size_t)
+    {
+        _decoded.push_back(input);
+    }
+    void ripple_empty(size_t) {}
+
+    // Inputs recovered since last call, in decoding order
+    std::vector<size_t> take()
+    {
+        return std::exchange(_decoded, {});
+    }
+
+    void clear()
+    {
+        _decoded.clear();
+    }
+
+private:
+    std::vector<size_t> _decoded;
+};
+
+inline void RingBufferObserver::push(DecoderEventType type, size_t symbol, size_t value)
+{
+    _events[_head & _mask] = DecoderEvent{type, symbol, value};
+    ++_head;
+}
+
+inline void RingBufferObserver::symbol_fed(size_t number, size_t degree)
+{
+    push(DecoderEventType::SymbolFed, number, degree);
+}
+
+inline void RingBufferObserver::symbol_released(size_t encoded, size_t input)
+{
+    push(DecoderEventType::SymbolReleased, encoded, input);
+}
+
+inline void RingBufferObserver::input_decoded(size_t input, size_t unknown)
+{
+    push(DecoderEventType::InputDecoded, input, unknown);
+}
+
+inline void RingBufferObserver::ripple_empty(size_t unknown)
+{
+    push(DecoderEventType::RippleEmpty, 0, unknown);
+}
+} // namespace Codes::Fountain
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Codes::Fountain {
+
+// Thread safe pool of warm codec instances. acquire() hands out an instance
+// already reset() for the new message, it goes back to the pool once the
+// lease is destroyed. Pool has to outlive its leases.
+template <typename Codec>
+class DecoderPool
+{
+public:
+    struct Release
+    {
+        DecoderPool* pool = nullptr;
+        void operator()(Codec* codec) const
+        {
+            pool->release(codec);
+        }
+    };
+    using Lease = std::unique_ptr<Codec, Release>;
+
+    explicit DecoderPool(std::function<Codec*()> factory, size_t max_idle = 64)
+        : _factory(std::move(factory))
+        , _max_idle(max_idle)
+    {}
+
+    Lease acquire(uint32_t seed, size_t data_size, size_t symbol_length)
+    {
+        std::unique_ptr<Codec> codec;
+        {
+            std::lock_guard lock(_mutex);
+            if (!_idle.empty())
+            {
+                codec = std::move(_idle.back());
+                _idle.pop_back();
+            }
+        }
+        if (codec)
+            codec->reset(seed, data_size, symbol_length);
+        else
+        {
+            codec.reset(_factory());
+            codec->set_seed(seed);
+            codec->set_input_data_size(data_size);
+            codec->set_symbol_length(symbol_length);
+        }
+        return Lease(codec.release(), Release{this});
+    }
+
+    size_t idle() const
+    {
+        std::lock_guard lock(_mutex);
+        return _idle.size();
+    }
+
+private:
+    void release(Codec* codec)
+    {
+        std::unique_ptr<Codec> owned(codec);
+        std::lock_guard lock(_mutex);
+        if (_idle.size() < _max_idle)
+            _idle.push_back(std::move(owned));
+    }
+
+    std::function<Codec*()> _factory;
+    size_t _max_idle = 0;
+    mutable std::mutex _mutex;
+    std::vector<std::unique_ptr<Codec>> _idle;
+};
+} // namespace Codes::Fountain
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Codes::Fountain {
+
+enum class Phase
+{
+    Feed,
+    Peel,
+    Eliminate,
+    BackSubstitute,
+    Count
+};
+
+// Plain counters, cheap enough to be always enabled. Cycle timers are
+// collected only after enable_timers(true).
+struct DecoderStats
+{
+    uint64_t symbols_received = 0;
+    uint64_t redundant_symbols = 0;
+    uint64_t useless_symbols = 0;
+    uint64_t corrupted_symbols = 0;
+    uint64_t bytes_xored = 0;
+    uint64_t ripple_high_water = 0;
+    uint64_t peeling_steps = 0;
+    uint64_t pivots = 0;
+    uint64_t row_operations = 0;
+    uint64_t phase_cycles[static_cast<size_t>(Phase::Count)] = {0};
+    bool timers_enabled = false;
+
+    void enable_timers(bool enable);
+    void reset();
+    void update_ripple(size_t ripple_size);
+    uint64_t cycles(Phase phase) const;
+    // Prometheus-like text exposition, one "<prefix>_<name> <value>" per line
+    std::string to_text(std::string_view prefix) const;
+
+    static uint64_t cycle_counter();
+};
+
+class PhaseTimer
+{
+public:
+    PhaseTimer(DecoderStats& stats, Phase phase);
+    ~PhaseTimer();
+    void stop();
+
+private:
+    DecoderStats& _stats;
+    Phase _phase;
+    uint64_t _start = 0;
+    bool _running = false;
+};
+
+inline void DecoderStats::update_ripple(size_t ripple_size)
+{
+    if (ripple_size > ripple_high_water)
+        ripple_high_water = ripple_size;
+}
+
+inline PhaseTimer::PhaseTimer(DecoderStats& stats, Phase phase)
+    : _stats(stats)
+    , _phase(phase)
+{
+    if (_stats.timers_enabled)
+    {
+        _running = true;
+        _start = DecoderStats::cycle_counter();
+    }
+}
+
+inline PhaseTimer::~PhaseTimer()
+{
+    stop();
+}
+
+inline void PhaseTimer::stop()
+{
+    if (!_running)
+        return;
+    _running = false;
+    _stats.phase_cycles[static_cast<size_t>(_phase)] += DecoderStats::cycle_counter() - _start;
+}
+} // namespace Codes::Fountain
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <string>
 #include <vector>
 
 namespace Codes::Fountain {
@@ -15,5 +16,18 @@ public:
     virtual void set_input_size(size_t input_symbols) = 0;
     virtual size_t symbol_degree() = 0;
     virtual std::vector<double> expected_distribution(size_t input_symbols) = 0;
+    // Identifies distribution type and parameters, equal keys give equal degree sequences.
+    // The default only names the type, code graphs and batch plans are not
+    // cached for distributions keeping it.
+    virtual std::string key() const;
+    // key() tells parameters apart
+    bool cacheable() const;
+
+protected:
+    // Inverse transform sampling over a table of degree probabilities,
+    // probabilities[d - 1] for degree d. Table is built from the first
+    // degrees entries, value is uniform in [0, 1).
+    static std::vector<double> cumulative_probabilities(const std::vector<double>& probabilities, size_t degrees);
+    static size_t sample_degree(const std::vector<double>& cumulative_probabilities, double value);
 };
 } // namespace Codes::Fountain
\ No newline at end of file
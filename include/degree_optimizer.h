@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "prng.h"
+#include "seed_search.h"
+
+namespace Codes::Fountain::DegreeOptimizer {
+
+// Hill climbing over degree probabilities for one K. Every step moves part
+// of the mass of one support degree to another and is kept only if the mean
+// loss free overhead over seeds [1, 1 + samples) drops. Overheads come from
+// the index only peeling simulation of SeedSearch, all candidates see the
+// same seeds.
+struct Options
+{
+    // Degrees allowed to carry probability, empty picks 1..8 and powers of
+    // two up to K. Degree 1 is always added.
+    std::vector<size_t> support;
+    size_t samples = 256;
+    size_t iterations = 300;
+    // Largest fraction of a degree's probability moved in one step
+    double step = 0.5;
+    // Seeds proposals
+    uint32_t seed = 1;
+    PrngType generator = PrngType::Well512;
+    size_t threads = std::thread::hardware_concurrency();
+};
+
+struct Result
+{
+    // probabilities[d - 1] for degree d, loads into TabulatedDistribution
+    std::vector<double> probabilities;
+    double mean_overhead = 0.0;
+    size_t accepted = 0;
+};
+
+// Mean loss free overhead of LT over seeds [first, first + samples), runs
+// that do not decode within 2K symbols count as K + 1
+double mean_overhead(const SeedSearch::DistributionFactory& distribution, size_t input_symbols, uint32_t first,
+                     size_t samples, const Options& options = {});
+// Starts from initial, or from IdealSolitonDistribution folded onto the
+// support when it is empty. Nothing to optimize for 0 input symbols, the
+// result is empty then.
+Result optimize(size_t input_symbols, const Options& options = {}, const std::vector<double>& initial = {});
+} // namespace Codes::Fountain::DegreeOptimizer
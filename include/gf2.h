@@ -0,0 +1,44 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+// Rows of GF(2) coefficients packed into 64 bit words, coefficient n is
+// bit n % 64 of word n / 64 (same order as prng fill_bits)
+namespace Codes::Fountain::GF2 {
+
+inline size_t words_for(size_t bits)
+{
+    return (bits + 63) / 64;
+}
+
+inline bool get_bit(const uint64_t* row, size_t idx)
+{
+    return (row[idx / 64] >> (idx % 64)) & 1;
+}
+
+inline void set_bit(uint64_t* row, size_t idx)
+{
+    row[idx / 64] |= uint64_t(1) << (idx % 64);
+}
+
+inline void clear_bit(uint64_t* row, size_t idx)
+{
+    row[idx / 64] &= ~(uint64_t(1) << (idx % 64));
+}
+
+inline size_t count_bits(const uint64_t* row, size_t words)
+{
+    size_t count = 0;
+    for (size_t idx = 0; idx < words; ++idx)
+        count += static_cast<size_t>(std::popcount(row[idx]));
+    return count;
+}
+
+inline void xor_row(uint64_t* dst, const uint64_t* src, size_t words)
+{
+    for (size_t idx = 0; idx < words; ++idx)
+        dst[idx] ^= src[idx];
+}
+} // namespace Codes::Fountain::GF2
\ No newline at end of file
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "codec_feed.h"
+#include "mpsc_queue.h"
+
+namespace Codes::Fountain {
+
+// Lets any number of receive threads push symbols into one decoder. A
+// dedicated consumer thread hands every drained batch to feed_symbols
+// straight from the queue arena, one decode pass per batch. Codec is only
+// touched by the consumer thread until the ingestor is destroyed.
+template <typename Codec>
+class Ingestor
+{
+public:
+    Ingestor(Codec& codec, size_t symbol_length, size_t capacity = 4096, size_t max_batch = 64)
+        : _codec(codec)
+        , _queue(capacity, symbol_length)
+        , _max_batch(max_batch)
+        , _completed(_promise.get_future().share())
+        , _consumer([this] { consume(); })
+    {}
+
+    ~Ingestor()
+    {
+        stop();
+    }
+
+    // Thread safe, false when queue is full or decoding is already finished
+    bool push(const char* symbol, size_t number)
+    {
+        if (_done.load(std::memory_order_relaxed))
+            return false;
+        return _queue.push(symbol, number);
+    }
+
+    // Becomes true once decoded, false if stopped before
+    std::shared_future<bool> completed() const
+    {
+        return _completed;
+    }
+
+    bool done() const
+    {
+        return _done;
+    }
+
+    void stop()
+    {
+        _queue.shutdown();
+        if (_consumer.joinable())
+            _consumer.join();
+    }
+
+private:
+    void consume()
+    {
+        auto decoded = false;
+        while (!decoded)
+        {
+            auto count = _queue.drain_batch(_max_batch, _batch, [this, &decoded](std::span<SymbolPacket> packets) {
+                decoded = feed_batch(_codec, packets);
+            });
+            if (count != 0)
+                continue;
+            if (_queue.is_shutdown())
+                break;
+            _queue.wait();
+        }
+        _done = true;
+        _promise.set_value(decoded);
+    }
+
+    Codec& _codec;
+    MpscSymbolQueue _queue;
+    std::vector<SymbolPacket> _batch;
+    size_t _max_batch = 0;
+    std::atomic<bool> _done{false};
+    std::promise<bool> _promise;
+    std::shared_future<bool> _completed;
+    std::thread _consumer;
+};
+} // namespace Codes::Fountain
\ No newline at end of file
@@ -2,48 +2,122 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <cstring>
 
+#include "decoder_observer.h"
+#include "decoder_stats.h"
 #include "degree_distribution.h"
 #include "node.h"
-#include "well512.h"
+#include "prng.h"
+#include "symbol_packet.h"
+#include "xor_kernel.h"
+#include "xor_program.h"
 
 namespace Codes::Fountain {
 
+class CodeGraph;
+
 enum class Decoding
 {
     Postpone,
     Start
 };
 
-class LT
+// Dumps the decoding graph with spdlog at trace level
+void trace_graph(const std::vector<Node>& data_nodes, const std::vector<Node>& encoded_nodes);
+
+// Observer receives ripple evolution events, see decoder_observer.h. Any
+// type with the observer members works, definitions are in lt.ipp and the
+// built-in observers declared below are instantiated once in lt.cpp.
+template <typename Observer>
+class BasicLT
 {
 public:
-    explicit LT(DegreeDistribution* distribution);
-    virtual ~LT();
+    explicit BasicLT(DegreeDistribution* distribution);
+    virtual ~BasicLT();
 
     void set_input_data(char* ptr, size_t len, bool deep_copy = false);
     void set_symbol_length(size_t len);
     void set_input_data_size(size_t len);
+    // Reinitialise for a new message, keeps node storage and up to one
+    // payload buffer per input symbol, clears the observer
+    void reset(uint32_t seed, size_t data_size, size_t symbol_length);
     char* generate_symbol();
+    void generate_symbol(size_t number, char* out);
+    // Encodes symbols [first, first + count) into out through one XorProgram,
+    // input subsets shared by several symbols are XORed only once. The plan
+    // of the last range is kept, encoding the same range again skips it.
+    void generate_symbols(size_t first, size_t count, char* out);
     void set_seed(uint32_t seed);
+    void set_generator(PrngType type);
+    // Rejects an RLF graph, a graph of another distribution or of another K
+    // once K is set, and every graph for a distribution without its own key(). A graph that does not match seed, K and generator at
+    // the time a symbol is loaded is skipped in favour of the generator.
+    bool set_code_graph(std::shared_ptr<const CodeGraph> graph);
+    // Symbols [0, K) are the input symbols themselves and peel without any
+    // XOR, repair symbols K, K + 1, ... are the regular symbols 0, 1, ...
+    void set_systematic(bool systematic);
+    // Payloads of droplets waiting in the graph are kept under budget bytes,
+    // the rest is spilled to scratch_path and read back, sorted by file
+    // offset, once a peeling round reaches them. Decoded inputs stay in
+    // memory. A budget of 0 turns spilling off.
+    bool set_memory_budget(size_t budget, const std::string& scratch_path);
+    size_t spilled_symbols() const;
     size_t symbol_degree();
     void shuffle_input_symbols(bool discard = false);
     void select_symbols(size_t num, size_t max, bool discard = false);
+    void load_symbol(size_t number);
 
     bool feed_symbol(char* ptr, size_t number, Memory mem = Memory::MakeCopy, Decoding dec = Decoding::Start);
+    // Symbol enters the graph only if tag matches symbol_tag(), see crc32c.h.
+    // Returns whether the tag matched, decode() tells if decoding is done.
+    bool feed_tagged_symbol(char* ptr, size_t number, uint32_t tag, Memory mem = Memory::MakeCopy,
+                            Decoding dec = Decoding::Start);
+    // Sorts packets by symbol number so neighbours are generated in one
+    // forward sweep, then runs a single decode pass for the whole batch
+    bool feed_symbols(std::span<SymbolPacket> packets, Memory mem = Memory::MakeCopy);
     bool decode(bool allow_partial = false);
     void process_encoded_node(size_t num);
     void process_input_node(size_t num);
+    void budget_droplet(size_t num);
+    // Scratch file errors are reported, a droplet that can not be spilled
+    // stays resident and one that can not be read back is dropped
+    bool spill(size_t num);
+    void page_in(std::vector<size_t>& ripple);
+    bool load_spilled(size_t num, char* out);
+    void release_droplet(size_t num);
+    void recycle_buffer(std::unique_ptr<char[]> buffer);
 
     char* decoded_buffer();
+    // Pending peeling runs first, then known inputs and the droplets still
+    // waiting in the graph are written, see snapshot.h for the layout
+    bool save_snapshot(const std::string& path);
+    // Decoder has to be built with the same distribution, symbols appended
+    // after the snapshot are fed and decoded as well
+    bool load_snapshot(const std::string& path);
+    // Inputs [0, N) are all recovered and may be consumed before decoding
+    // ends, updated by every decode pass. A ProgressObserver tells which
+    // inputs the last passes recovered.
+    size_t decoded_prefix() const;
+    // Recovered input payload, nullptr while still unknown
+    const char* input_symbol(size_t idx) const;
+    const DecoderStats& stats() const;
+    DecoderStats& stats();
+    Observer& observer();
 
     void print_hash_matrix();
 
     std::unique_ptr<DegreeDistribution> _degree_dist;
     size_t _symbol_length = 0;
+    XorKernel _xor = xor_generic;
     size_t _input_symbols = 0;
     size_t _input_data_size = 0;
     char* _input_data = nullptr;
@@ -51,16 +125,73 @@ public:
 
     std::vector<uint32_t> _current_hash_bits;
     std::vector<uint32_t> _samples;
+    std::vector<std::vector<uint32_t>> _batch_sets;
+    std::vector<char> _batch_scratch;
+    // neighbour sets of a generate_symbols range depend on these only
+    struct BatchKey
+    {
+        size_t first = 0;
+        size_t count = 0;
+        size_t input_symbols = 0;
+        uint32_t seed = 0;
+        PrngType generator = PrngType::Well512;
+        bool systematic = false;
+        std::string distribution;
+
+        bool operator==(const BatchKey&) const = default;
+    };
+    BatchKey _batch_key;
+    std::optional<XorProgram> _batch_program;
     size_t _current_symbol = 0;
+    // _current_hash_bits hold generated symbol _current_symbol - 1, graph
+    // and systematic symbols overwrite them without moving the generator
+    bool _hash_bits_generated = false;
+    size_t _next_symbol = 0;
+    uint32_t _seed = 0;
+    bool _systematic = false;
 
-    well_512 _generator;
+    Prng _generator;
+    std::shared_ptr<const CodeGraph> _graph;
 
     std::vector<Node> _data_nodes;
     std::vector<Node> _encoded_nodes;
 
     std::vector<size_t> _data_queue;
     std::vector<size_t> _encoded_queue;
+    std::vector<std::unique_ptr<char[]>> _spare_buffers;
+
+    struct Spill
+    {
+        uint64_t offset = 0;
+        // edges at spill time, inputs recovered since are XORed on page in
+        std::vector<size_t> edges;
+    };
+
+    // payloads of spilled and dropped droplets are not pooled beyond this
+    // while a budget is set
+    static constexpr size_t budget_spare_buffers = 4;
+    size_t _memory_budget = 0;
+    size_t _resident_bytes = 0;
+    uint64_t _scratch_end = 0;
+    std::fstream _scratch;
+    std::vector<bool> _budgeted;
+    std::unordered_map<size_t, Spill> _spilled;
 
     size_t _unknown_blocks = 0;
+    size_t _prefix = 0;
+
+    DecoderStats _stats;
+    [[no_unique_address]] Observer _observer;
 };
+} // namespace Codes::Fountain
+
+#include "lt.ipp"
+
+namespace Codes::Fountain {
+extern template class BasicLT<NullObserver>;
+extern template class BasicLT<RingBufferObserver>;
+extern template class BasicLT<TraceObserver>;
+extern template class BasicLT<ProgressObserver>;
+
+using LT = BasicLT<NullObserver>;
 } // namespace Codes::Fountain
\ No newline at end of file
@@ -0,0 +1,723 @@
+#pragma once
+
+// Definitions of BasicLT, included by lt.h so decoders can be instantiated
+// with any observer. Built-in observers are instantiated once in lt.cpp.
+
+#include "code_graph.h"
+#include "crc32c.h"
+#include "snapshot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <set>
+#include <span>
+
+namespace Codes::Fountain {
+
+template <typename Observer>
+BasicLT<Observer>::BasicLT(DegreeDistribution* distribution)
+    : _degree_dist(distribution)
+{}
+
+template <typename Observer>
+BasicLT<Observer>::~BasicLT()
+{
+    if (_owner)
+        delete[] _input_data;
+}
+
+template <typename Observer>
+void BasicLT<Observer>::set_input_data(char* ptr, size_t len, bool deep_copy)
+{
+    if (deep_copy)
+    {
+        _owner = true;
+        _input_data = new char[len];
+        memcpy(_input_data, ptr, len);
+    }
+    else
+        _input_data = ptr;
+
+    set_input_data_size(len);
+}
+
+template <typename Observer>
+void BasicLT<Observer>::set_symbol_length(size_t len)
+{
+    _symbol_length = len;
+    _xor = select_xor_kernel(_symbol_length);
+    _input_symbols = _input_data_size / _symbol_length;
+    _encoded_nodes.reserve(static_cast<size_t>(1.2 * static_cast<double>(_input_symbols)));
+    _current_hash_bits.reserve(_input_symbols);
+    _degree_dist->set_input_size(_input_symbols);
+
+    _data_nodes.resize(_input_symbols);
+    _samples.resize(_input_symbols);
+    std::iota(_samples.begin(), _samples.end(), 0);
+
+    _unknown_blocks = _input_symbols;
+    _prefix = 0;
+}
+
+template <typename Observer>
+void BasicLT<Observer>::reset(uint32_t seed, size_t data_size, size_t symbol_length)
+{
+    // Owner feeds hand their buffers over too, keep no more than the next
+    // message can take back through MakeCopy feeds
+    auto spare_limit = symbol_length == _symbol_length ? data_size / symbol_length : 0;
+    if (_memory_budget != 0)
+        spare_limit = std::min(spare_limit, budget_spare_buffers);
+    if (_spare_buffers.size() > spare_limit)
+        _spare_buffers.resize(spare_limit);
+    for (auto* nodes : {&_data_nodes, &_encoded_nodes})
+        for (auto& node : *nodes)
+        {
+            auto buffer = node.take_data();
+            if (buffer && _spare_buffers.size() < spare_limit)
+                _spare_buffers.push_back(std::move(buffer));
+            node.reset();
+        }
+    if (data_size / symbol_length < _data_nodes.size())
+        _data_nodes.resize(data_size / symbol_length);
+    _encoded_nodes.clear();
+    _budgeted.clear();
+    _spilled.clear();
+    _resident_bytes = 0;
+    _scratch_end = 0;
+    _data_queue.clear();
+    _encoded_queue.clear();
+
+    if (_owner)
+        delete[] _input_data;
+    _input_data = nullptr;
+    _owner = false;
+    // graph belongs to the previous (seed, K), set it again if still valid
+    _graph.reset();
+    _next_symbol = 0;
+    _stats.reset();
+    if constexpr (requires { _observer.clear(); })
+        _observer.clear();
+
+    set_seed(seed);
+    set_input_data_size(data_size);
+    set_symbol_length(symbol_length);
+}
+
+template <typename Observer>
+void BasicLT<Observer>::set_input_data_size(size_t len)
+{
+    _input_data_size = len;
+}
+
+template <typename Observer>
+char* BasicLT<Observer>::generate_symbol()
+{
+    auto* ptr = new char[_symbol_length];
+    generate_symbol(_next_symbol++, ptr);
+    return ptr;
+}
+
+template <typename Observer>
+void BasicLT<Observer>::generate_symbol(size_t number, char* out)
+{
+    if (_systematic && number < _input_symbols)
+    {
+        memcpy(out, _input_data + number * _symbol_length, _symbol_length);
+        return;
+    }
+    memset(out, 0, _symbol_length);
+    char* input = nullptr;
+    load_symbol(number);
+
+    for (auto idx = size_t{0}; idx < _current_hash_bits.size(); ++idx)
+    {
+        input = _input_data + _current_hash_bits[idx] * _symbol_length;
+        _xor(out, input, _symbol_length);
+    }
+}
+
+template <typename Observer>
+void BasicLT<Observer>::generate_symbols(size_t first, size_t count, char* out)
+{
+    BatchKey key{first, count, _input_symbols, _seed, _generator.type(), _systematic, _degree_dist->key()};
+    if (!_batch_program || key != _batch_key || !_degree_dist->cacheable())
+    {
+        _batch_sets.resize(count);
+        for (size_t idx = 0; idx < count; ++idx)
+        {
+            load_symbol(first + idx);
+            _batch_sets[idx].assign(_current_hash_bits.cbegin(), _current_hash_bits.cend());
+        }
+        _batch_program = XorProgram::plan(_batch_sets, _input_symbols);
+        _batch_key = std::move(key);
+    }
+    _batch_program->execute(_input_data, _symbol_length, _xor, out, _batch_scratch);
+}
+
+template <typename Observer>
+void BasicLT<Observer>::set_seed(uint32_t seed)
+{
+    _seed = seed;
+    _generator.set_seed(seed);
+    _degree_dist->set_seed(seed);
+    _current_symbol = 0;
+}
+
+template <typename Observer>
+void BasicLT<Observer>::set_generator(PrngType type)
+{
+    _generator.set_type(type);
+}
+
+template <typename Observer>
+bool BasicLT<Observer>::set_code_graph(std::shared_ptr<const CodeGraph> graph)
+{
+    if (graph && (graph->kind() != CodeGraph::Kind::Lt || !_degree_dist->cacheable() ||
+                  graph->distribution() != _degree_dist->key() ||
+                  (_input_symbols != 0 && graph->input_symbols() != _input_symbols)))
+        return false;
+    _graph = std::move(graph);
+    return true;
+}
+
+template <typename Observer>
+void BasicLT<Observer>::set_systematic(bool systematic)
+{
+    _systematic = systematic;
+}
+
+template <typename Observer>
+bool BasicLT<Observer>::set_memory_budget(size_t budget, const std::string& scratch_path)
+{
+    _memory_budget = budget;
+    _scratch.close();
+    if (budget == 0)
+        return true;
+    if (_spare_buffers.size() > budget_spare_buffers)
+        _spare_buffers.resize(budget_spare_buffers);
+    _scratch.open(scratch_path, std::ios::binary | std::ios::in | std::ios::out | std::ios::trunc);
+    return _scratch.is_open();
+}
+
+template <typename Observer>
+size_t BasicLT<Observer>::spilled_symbols() const
+{
+    return _spilled.size();
+}
+
+template <typename Observer>
+size_t BasicLT<Observer>::symbol_degree()
+{
+    return _degree_dist->symbol_degree();
+}
+
+template <typename Observer>
+void BasicLT<Observer>::shuffle_input_symbols(bool discard)
+{
+    select_symbols(symbol_degree(), _input_symbols, discard);
+}
+
+template <typename Observer>
+void BasicLT<Observer>::select_symbols(size_t num, size_t, bool)
+{
+    _current_hash_bits.clear();
+    std::set<uint32_t> choosen;
+    while (choosen.size() < num)
+    {
+        auto value = static_cast<uint32_t>(_generator() % _samples.size());
+        choosen.insert(value);
+    }
+    for (const auto& val : choosen)
+        _current_hash_bits.push_back(val);
+}
+
+template <typename Observer>
+void BasicLT<Observer>::load_symbol(size_t number)
+{
+    if (_systematic)
+    {
+        if (number < _input_symbols)
+        {
+            _current_hash_bits.assign(1, static_cast<uint32_t>(number));
+            _hash_bits_generated = false;
+            return;
+        }
+        number -= _input_symbols;
+    }
+    if (_graph && number < _graph->symbols() && _graph->matches(_seed, _input_symbols, _generator.type()))
+    {
+        auto neighbors = _graph->neighbors(number);
+        _current_hash_bits.assign(neighbors.begin(), neighbors.end());
+        _hash_bits_generated = false;
+        return;
+    }
+    // reloading the last generated symbol, its neighbours are still there
+    if (number + 1 == _current_symbol && _hash_bits_generated)
+        return;
+    // graph did not advance the generator, catch up from its own position
+    if (number < _current_symbol)
+        set_seed(_seed);
+    while (_current_symbol != number + 1)
+    {
+        shuffle_input_symbols(_current_symbol != number);
+        ++_current_symbol;
+    }
+    _hash_bits_generated = true;
+}
+
+template <typename Observer>
+bool BasicLT<Observer>::feed_symbol(char* ptr, size_t number, Memory mem, Decoding dec)
+{
+    PhaseTimer timer(_stats, Phase::Feed);
+    ++_stats.symbols_received;
+    if (_unknown_blocks == 0)
+        ++_stats.redundant_symbols;
+    load_symbol(number);
+    if (mem == Memory::MakeCopy && !_spare_buffers.empty())
+    {
+        auto buffer = std::move(_spare_buffers.back());
+        _spare_buffers.pop_back();
+        memcpy(buffer.get(), ptr, _symbol_length);
+        ptr = buffer.release();
+        mem = Memory::Owner;
+    }
+    Node node(ptr, _symbol_length, mem);
+    node.init_edges(std::vector<size_t>(_current_hash_bits.cbegin(), _current_hash_bits.cend()));
+    ptr = node.get_data();
+    for (const auto& input_node_num : _current_hash_bits)
+    {
+        if (_data_nodes[input_node_num].is_known())
+        {
+            node.erase_edge(input_node_num);
+            _xor(ptr, _data_nodes[input_node_num].get_data(), _symbol_length);
+            _stats.bytes_xored += _symbol_length;
+        }
+        _data_nodes[input_node_num].add_edge(_encoded_nodes.size());
+    }
+
+    if (node.edges_num() == 1)
+    {
+        _encoded_queue.push_back(_encoded_nodes.size());
+        _stats.update_ripple(_encoded_queue.size());
+    }
+    else if (node.edges_num() == 0)
+        ++_stats.useless_symbols;
+    _observer.symbol_fed(number, node.edges_num());
+    _encoded_nodes.push_back(std::move(node));
+    budget_droplet(_encoded_nodes.size() - 1);
+    timer.stop();
+    return dec == Decoding::Start && decode();
+}
+
+template <typename Observer>
+bool BasicLT<Observer>::feed_tagged_symbol(char* ptr, size_t number, uint32_t tag, Memory mem, Decoding dec)
+{
+    if (symbol_tag(ptr, _symbol_length, number) != tag)
+    {
+        ++_stats.corrupted_symbols;
+        if (mem == Memory::Owner)
+            delete[] ptr;
+        return false;
+    }
+    feed_symbol(ptr, number, mem, dec);
+    return true;
+}
+
+template <typename Observer>
+bool BasicLT<Observer>::feed_symbols(std::span<SymbolPacket> packets, Memory mem)
+{
+    std::sort(packets.begin(), packets.end(),
+              [](const SymbolPacket& lhs, const SymbolPacket& rhs) { return lhs.number < rhs.number; });
+    for (const auto& packet : packets)
+        feed_symbol(packet.data, packet.number, mem, Decoding::Postpone);
+    return decode();
+}
+
+template <typename Observer>
+bool BasicLT<Observer>::decode(bool)
+{
+    if (_unknown_blocks != 0)
+    {
+        PhaseTimer timer(_stats, Phase::Peel);
+        while (!_data_queue.empty() || !_encoded_queue.empty())
+        {
+            std::vector<size_t> tmp_encoded_queue;
+            std::vector<size_t> tmp_data_queue;
+            std::swap(_encoded_queue, tmp_encoded_queue);
+            std::swap(_data_queue, tmp_data_queue);
+
+            if (!_spilled.empty())
+                page_in(tmp_encoded_queue);
+            for (auto idx : tmp_encoded_queue)
+                process_encoded_node(idx);
+            for (auto idx : tmp_data_queue)
+                process_input_node(idx);
+        }
+        if (_unknown_blocks != 0)
+            _observer.ripple_empty(_unknown_blocks);
+        while (_prefix < _input_symbols && _data_nodes[_prefix].is_known())
+            ++_prefix;
+    }
+    return _unknown_blocks == 0;
+}
+
+template <typename Observer>
+void BasicLT<Observer>::process_encoded_node(size_t num)
+{
+    Node& node = _encoded_nodes[num];
+    if (node.edges_num() != 1)
+        return;
+    auto edge = node.edge_at(0);
+    _observer.symbol_released(num, edge);
+    node.clear_edges();
+    if (_memory_budget != 0)
+        release_droplet(num);
+    if (_data_nodes[edge].is_known())
+    {
+        ++_stats.useless_symbols;
+        return;
+    }
+
+    _data_nodes[edge].swap_with(node);
+    _data_nodes[edge].make_known();
+    _data_nodes[edge].erase_edge(num);
+    --_unknown_blocks;
+    ++_stats.peeling_steps;
+    _observer.input_decoded(edge, _unknown_blocks);
+    _data_queue.push_back(edge);
+}
+
+template <typename Observer>
+void BasicLT<Observer>::process_input_node(size_t num)
+{
+    for (const auto& edge : _data_nodes[num].edges())
+    {
+        auto& droplet = _encoded_nodes[edge];
+        droplet.erase_edge(num);
+
+        if (droplet.edges_num() == 0)
+        {
+            // droplet carries nothing new, its buffer counts against the budget
+            if (_memory_budget != 0)
+            {
+                release_droplet(edge);
+                recycle_buffer(droplet.take_data());
+            }
+            continue;
+        }
+        else if (droplet.get_data() != nullptr)
+        {
+            _xor(droplet.get_data(), _data_nodes[num].get_data(), _symbol_length);
+            _stats.bytes_xored += _symbol_length;
+        }
+
+        if (_encoded_nodes[edge].edges_num() == 1)
+        {
+            _encoded_queue.push_back(edge);
+            _stats.update_ripple(_encoded_queue.size());
+        }
+    }
+    _data_nodes[num].clear_edges();
+}
+
+// Droplet just appended to the graph, a pending one stays resident while
+// it fits in the budget and is spilled otherwise
+template <typename Observer>
+void BasicLT<Observer>::budget_droplet(size_t num)
+{
+    _budgeted.push_back(false);
+    if (_memory_budget == 0 || _encoded_nodes[num].edges_num() < 2)
+        return;
+    if (_resident_bytes + _symbol_length > _memory_budget && spill(num))
+        return;
+    _budgeted[num] = true;
+    _resident_bytes += _symbol_length;
+}
+
+template <typename Observer>
+bool BasicLT<Observer>::spill(size_t num)
+{
+    auto& node = _encoded_nodes[num];
+    if (!_scratch.seekp(static_cast<std::streamoff>(_scratch_end)) ||
+        !_scratch.write(node.get_data(), static_cast<std::streamsize>(_symbol_length)))
+    {
+        _scratch.clear();
+        return false;
+    }
+    _spilled[num] = Spill{_scratch_end, node.edges()};
+    _scratch_end += _symbol_length;
+    recycle_buffer(node.take_data());
+    return true;
+}
+
+// Whole ripple round is read at once in file order, droplets whose input
+// is already known are dropped without reading
+template <typename Observer>
+void BasicLT<Observer>::page_in(std::vector<size_t>& ripple)
+{
+    std::vector<std::pair<uint64_t, size_t>> reads;
+    for (auto num : ripple)
+    {
+        auto spilled = _spilled.find(num);
+        if (spilled == _spilled.end())
+            continue;
+        const auto& node = _encoded_nodes[num];
+        if (node.edges_num() == 1 && !_data_nodes[node.edge_at(0)].is_known())
+            reads.emplace_back(spilled->second.offset, num);
+        else if (node.edges_num() == 1)
+            _spilled.erase(spilled);
+    }
+    std::sort(reads.begin(), reads.end());
+    for (const auto& [offset, num] : reads)
+    {
+        std::unique_ptr<char[]> buffer;
+        if (_spare_buffers.empty())
+            buffer.reset(new char[_symbol_length]);
+        else
+        {
+            buffer = std::move(_spare_buffers.back());
+            _spare_buffers.pop_back();
+        }
+        if (!load_spilled(num, buffer.get()))
+        {
+            // payload is gone, the droplet leaves the graph unused
+            _encoded_nodes[num].clear_edges();
+            release_droplet(num);
+            recycle_buffer(std::move(buffer));
+            continue;
+        }
+        Node loaded(buffer.release(), _symbol_length, Memory::Owner);
+        _encoded_nodes[num].swap_with(loaded);
+        _spilled.erase(num);
+    }
+}
+
+template <typename Observer>
+bool BasicLT<Observer>::load_spilled(size_t num, char* out)
+{
+    const auto& spilled = _spilled.at(num);
+    if (!_scratch.seekg(static_cast<std::streamoff>(spilled.offset)) ||
+        !_scratch.read(out, static_cast<std::streamsize>(_symbol_length)))
+    {
+        _scratch.clear();
+        return false;
+    }
+    const auto& edges = _encoded_nodes[num].edges();
+    for (auto input : spilled.edges)
+    {
+        if (std::find(edges.cbegin(), edges.cend(), input) != edges.cend())
+            continue;
+        _xor(out, _data_nodes[input].get_data(), _symbol_length);
+        _stats.bytes_xored += _symbol_length;
+    }
+    return true;
+}
+
+template <typename Observer>
+void BasicLT<Observer>::release_droplet(size_t num)
+{
+    if (_budgeted[num])
+    {
+        _budgeted[num] = false;
+        _resident_bytes -= _symbol_length;
+    }
+    _spilled.erase(num);
+}
+
+template <typename Observer>
+void BasicLT<Observer>::recycle_buffer(std::unique_ptr<char[]> buffer)
+{
+    if (buffer && (_memory_budget == 0 || _spare_buffers.size() < budget_spare_buffers))
+        _spare_buffers.push_back(std::move(buffer));
+}
+
+template <typename Observer>
+size_t BasicLT<Observer>::decoded_prefix() const
+{
+    return _prefix;
+}
+
+template <typename Observer>
+const char* BasicLT<Observer>::input_symbol(size_t idx) const
+{
+    return _data_nodes[idx].is_known() ? _data_nodes[idx].get_data() : nullptr;
+}
+
+template <typename Observer>
+char* BasicLT<Observer>::decoded_buffer()
+{
+    auto buffer = new char[_input_data_size];
+    for (auto idx = size_t{0}; idx < _input_symbols; ++idx)
+        memcpy(buffer + idx * _symbol_length, _data_nodes[idx].get_data(), _symbol_length);
+    return buffer;
+}
+
+template <typename Observer>
+bool BasicLT<Observer>::save_snapshot(const std::string& path)
+{
+    decode();
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        return false;
+
+    Snapshot::Header header;
+    header.kind = Snapshot::Kind::LT;
+    header.seed = _seed;
+    header.generator = static_cast<uint32_t>(_generator.type());
+    header.flags = _systematic ? Snapshot::systematic_flag : 0;
+    header.data_size = _input_data_size;
+    header.symbol_length = _symbol_length;
+    Snapshot::write_header(out, header, _degree_dist->key());
+    Snapshot::write_stats(out, _stats);
+
+    auto length = static_cast<std::streamsize>(_symbol_length);
+    for (const auto& node : _data_nodes)
+    {
+        auto known = static_cast<uint8_t>(node.is_known());
+        Snapshot::write(out, known);
+        if (known)
+            out.write(node.get_data(), length);
+    }
+    // once everything is known the remaining droplets carry no information
+    uint64_t pending = 0;
+    if (_unknown_blocks != 0)
+        pending = static_cast<uint64_t>(std::count_if(_encoded_nodes.cbegin(), _encoded_nodes.cend(),
+                                                      [](const Node& node) { return node.edges_num() != 0; }));
+    Snapshot::write(out, pending);
+    std::vector<char> payload(_symbol_length);
+    for (const auto& node : _encoded_nodes)
+    {
+        if (pending == 0)
+            break;
+        if (node.edges_num() == 0)
+            continue;
+        Snapshot::write(out, static_cast<uint32_t>(node.edges_num()));
+        for (auto edge : node.edges())
+            Snapshot::write(out, static_cast<uint32_t>(edge));
+        if (node.get_data() == nullptr)
+        {
+            if (!load_spilled(static_cast<size_t>(&node - _encoded_nodes.data()), payload.data()))
+                return false;
+            out.write(payload.data(), length);
+        }
+        else
+            out.write(node.get_data(), length);
+        --pending;
+    }
+    return static_cast<bool>(out.flush());
+}
+
+template <typename Observer>
+bool BasicLT<Observer>::load_snapshot(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    Snapshot::Header header;
+    std::string key;
+    DecoderStats stats;
+    if (!in || !Snapshot::read_header(in, Snapshot::Kind::LT, header, key) || key != _degree_dist->key() ||
+        header.symbol_length == 0 || !Snapshot::read_stats(in, stats))
+        return false;
+
+    // whole snapshot is read before the decoder is touched, a broken file
+    // leaves it as it was
+    auto input_symbols = header.data_size / header.symbol_length;
+    auto length = static_cast<std::streamsize>(header.symbol_length);
+    std::vector<size_t> known;
+    std::vector<char> known_payloads;
+    for (size_t idx = 0; idx < input_symbols; ++idx)
+    {
+        uint8_t flag = 0;
+        if (!Snapshot::read(in, flag))
+            return false;
+        if (!flag)
+            continue;
+        known.push_back(idx);
+        known_payloads.resize(known.size() * header.symbol_length);
+        if (!in.read(known_payloads.data() + known_payloads.size() - header.symbol_length, length))
+            return false;
+    }
+
+    uint64_t pending = 0;
+    if (!Snapshot::read(in, pending))
+        return false;
+    std::vector<std::vector<size_t>> droplet_edges;
+    std::vector<char> droplet_payloads;
+    for (; pending != 0; --pending)
+    {
+        uint32_t edges_num = 0;
+        if (!Snapshot::read(in, edges_num))
+            return false;
+        auto& edges = droplet_edges.emplace_back(edges_num);
+        for (auto& edge : edges)
+        {
+            uint32_t value = 0;
+            if (!Snapshot::read(in, value) || value >= input_symbols)
+                return false;
+            edge = value;
+        }
+        droplet_payloads.resize(droplet_edges.size() * header.symbol_length);
+        if (!in.read(droplet_payloads.data() + droplet_payloads.size() - header.symbol_length, length))
+            return false;
+    }
+
+    set_generator(static_cast<PrngType>(header.generator));
+    set_systematic(header.flags & Snapshot::systematic_flag);
+    reset(header.seed, header.data_size, header.symbol_length);
+    stats.timers_enabled = _stats.timers_enabled;
+    _stats = stats;
+
+    for (size_t idx = 0; idx < known.size(); ++idx)
+    {
+        Node restored(known_payloads.data() + idx * _symbol_length, _symbol_length);
+        _data_nodes[known[idx]].swap_with(restored);
+        _data_nodes[known[idx]].make_known();
+        --_unknown_blocks;
+    }
+    while (_prefix < _input_symbols && _data_nodes[_prefix].is_known())
+        ++_prefix;
+
+    for (size_t idx = 0; idx < droplet_edges.size(); ++idx)
+    {
+        for (auto edge : droplet_edges[idx])
+            _data_nodes[edge].add_edge(_encoded_nodes.size());
+        Node node(droplet_payloads.data() + idx * _symbol_length, _symbol_length);
+        node.init_edges(std::move(droplet_edges[idx]));
+        _encoded_nodes.push_back(std::move(node));
+        budget_droplet(_encoded_nodes.size() - 1);
+    }
+
+    // a torn append at the end is where the journal stops
+    std::vector<char> payload(_symbol_length);
+    uint64_t number = 0;
+    while (Snapshot::read_symbol(in, _symbol_length, number, payload.data()))
+        feed_symbol(payload.data(), number, Memory::MakeCopy, Decoding::Postpone);
+    decode();
+    return true;
+}
+
+template <typename Observer>
+const DecoderStats& BasicLT<Observer>::stats() const
+{
+    return _stats;
+}
+
+template <typename Observer>
+DecoderStats& BasicLT<Observer>::stats()
+{
+    return _stats;
+}
+
+template <typename Observer>
+Observer& BasicLT<Observer>::observer()
+{
+    return _observer;
+}
+
+template <typename Observer>
+void BasicLT<Observer>::print_hash_matrix()
+{
+    trace_graph(_data_nodes, _encoded_nodes);
+}
+} // namespace Codes::Fountain
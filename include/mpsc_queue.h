@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "symbol_packet.h"
+
+namespace Codes::Fountain {
+
+// Bounded lock free multi producer, single consumer queue of fixed size
+// symbols (Vyukov style sequence numbers per cell). Payload is copied into
+// the queue arena, so producers never allocate. push() fails when full.
+class MpscSymbolQueue
+{
+public:
+    MpscSymbolQueue(size_t capacity, size_t symbol_length);
+
+    bool push(const char* symbol, size_t number);
+    bool empty() const;
+    // Consumer only, visit(const char* symbol, size_t number) for up to max symbols
+    template <typename Visitor>
+    size_t drain(size_t max, Visitor&& visit);
+    // Consumer only, feed(std::span<SymbolPacket>) gets up to max symbols
+    // pointing into the arena at once, their cells are released afterwards
+    template <typename Feed>
+    size_t drain_batch(size_t max, std::vector<SymbolPacket>& packets, Feed&& feed);
+    // Consumer only, blocks until queue is not empty or shutdown() was called
+    void wait();
+    void shutdown();
+    bool is_shutdown() const;
+
+    size_t capacity() const;
+    size_t symbol_length() const;
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        size_t number;
+    };
+
+    size_t _mask = 0;
+    size_t _symbol_length = 0;
+    std::unique_ptr<Cell[]> _cells;
+    std::unique_ptr<char[]> _arena;
+    alignas(64) std::atomic<size_t> _enqueue{0};
+    alignas(64) size_t _dequeue = 0;
+    std::atomic<bool> _sleeping{false};
+    std::atomic<bool> _shutdown{false};
+};
+
+template <typename Visitor>
+size_t MpscSymbolQueue::drain(size_t max, Visitor&& visit)
+{
+    size_t count = 0;
+    for (; count < max; ++count)
+    {
+        auto& cell = _cells[_dequeue & _mask];
+        if (cell.sequence.load(std::memory_order_acquire) != _dequeue + 1)
+            break;
+        visit(static_cast<const char*>(_arena.get() + (_dequeue & _mask) * _symbol_length), cell.number);
+        cell.sequence.store(_dequeue + _mask + 1, std::memory_order_release);
+        ++_dequeue;
+    }
+    return count;
+}
+
+template <typename Feed>
+size_t MpscSymbolQueue::drain_batch(size_t max, std::vector<SymbolPacket>& packets, Feed&& feed)
+{
+    packets.clear();
+    for (auto position = _dequeue; packets.size() < max; ++position)
+    {
+        auto& cell = _cells[position & _mask];
+        if (cell.sequence.load(std::memory_order_acquire) != position + 1)
+            break;
+        packets.push_back(SymbolPacket{_arena.get() + (position & _mask) * _symbol_length, cell.number});
+    }
+    if (packets.empty())
+        return 0;
+    feed(std::span<SymbolPacket>(packets));
+    for (size_t idx = 0; idx < packets.size(); ++idx, ++_dequeue)
+        _cells[_dequeue & _mask].sequence.store(_dequeue + _mask + 1, std::memory_order_release);
+    return packets.size();
+}
+} // namespace Codes::Fountain
\ No newline at end of file
@@ -30,6 +30,10 @@ struct Node
     size_t edge_at(size_t idx) const;
     void make_known();
     void swap_with(Node& other);
+    // Hands over the buffer if node owns it, node is left without data
+    std::unique_ptr<char[]> take_data();
+    // Back to the state of a default constructed node, edges keep capacity
+    void reset();
 
 private:
     std::vector<size_t> _edges;
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "well512.h"
+#include "xoshiro256.h"
+
+namespace Codes::Fountain {
+
+enum class PrngType
+{
+    Well512,
+    Xoshiro256
+};
+
+// Codec generator, both sides have to select the same type before set_seed
+class Prng
+{
+public:
+    void set_type(PrngType type)
+    {
+        _type = type;
+    }
+
+    PrngType type() const
+    {
+        return _type;
+    }
+
+    void set_seed(uint32_t seed)
+    {
+        if (_type == PrngType::Well512)
+            _well.set_seed(seed);
+        else
+            _xoshiro.set_seed(seed);
+    }
+
+    uint64_t operator()()
+    {
+        return _type == PrngType::Well512 ? _well() : _xoshiro();
+    }
+
+    double rand_float()
+    {
+        return _type == PrngType::Well512 ? _well.rand_float() : _xoshiro.rand_float();
+    }
+
+    uint8_t rand_bit()
+    {
+        return _type == PrngType::Well512 ? _well.rand_bit() : _xoshiro.rand_bit();
+    }
+
+    void fill(uint64_t* out, size_t count)
+    {
+        if (_type == PrngType::Well512)
+            _well.fill(out, count);
+        else
+            _xoshiro.fill(out, count);
+    }
+
+    void fill_float(double* out, size_t count)
+    {
+        if (_type == PrngType::Well512)
+            _well.fill_float(out, count);
+        else
+            _xoshiro.fill_float(out, count);
+    }
+
+    void fill_bits(uint64_t* out, size_t bits)
+    {
+        if (_type == PrngType::Well512)
+            _well.fill_bits(out, bits);
+        else
+            _xoshiro.fill_bits(out, bits);
+    }
+
+    void discard_bits(size_t bits)
+    {
+        if (_type == PrngType::Well512)
+            _well.discard_bits(bits);
+        else
+            _xoshiro.discard_bits(bits);
+    }
+
+private:
+    PrngType _type = PrngType::Well512;
+    well_512 _well;
+    xoshiro_256 _xoshiro;
+};
+} // namespace Codes::Fountain
\ No newline at end of file
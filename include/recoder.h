@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "prng.h"
+#include "xor_kernel.h"
+
+namespace Codes::Fountain {
+
+// Relay side mixing of RLF symbols in explicit coefficient mode. Received
+// combinations are buffered without decoding and every recoded symbol is a
+// fresh random GF(2) combination of the buffer, so one symbol costs
+// O(buffer) XORs instead of a full decode. The generator is local to the
+// relay, coefficients travel with the symbol. A full buffer replaces its
+// oldest entry.
+class Recoder
+{
+public:
+    Recoder(size_t input_symbols, size_t symbol_length, size_t capacity);
+
+    void set_seed(uint32_t seed);
+    void set_generator(PrngType type);
+
+    size_t row_words() const;
+    size_t size() const;
+    // Returns false for a combination without any coefficient set
+    bool add_symbol(const char* data, const uint64_t* coefficients);
+    // Returns false while nothing has been buffered yet
+    bool recode(char* out, uint64_t* coefficients);
+
+private:
+    size_t _symbol_length = 0;
+    size_t _row_words = 0;
+    size_t _capacity = 0;
+    size_t _size = 0;
+    size_t _next = 0;
+    XorKernel _xor = xor_generic;
+    Prng _generator;
+
+    std::vector<uint64_t> _rows;
+    std::vector<char> _payloads;
+    std::vector<uint64_t> _mix;
+};
+} // namespace Codes::Fountain
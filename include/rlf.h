@@ -1,12 +1,20 @@
 #pragma once
 
 #include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
 #include <vector>
 
-#include "well512.h"
+#include "decoder_stats.h"
+#include "prng.h"
+#include "symbol_packet.h"
+#include "xor_kernel.h"
 
 namespace Codes {
 namespace Fountain {
+class CodeGraph;
+
 class RLF
 {
 public:
@@ -16,29 +24,90 @@ public:
     void set_input_data(char* ptr, size_t len, bool deep_copy = false);
     void set_symbol_length(size_t len);
     void set_input_data_size(size_t len);
+    // Reinitialise for a new message, keeps row and symbol buffers
+    void reset(uint32_t seed, size_t data_size, size_t symbol_length);
     char* generate_symbol();
+    void generate_symbol(size_t number, char* out);
+    // Endless encoder, coefficients only live in a reused scratch row and
+    // generate_symbol() stops keeping a row per symbol, so memory stays
+    // constant however many symbols are produced
+    void set_streaming(bool streaming);
+    // Next symbol of the stream written to out, returns its number
+    size_t next_symbol(char* out);
     void set_seed(uint32_t seed);
+    void set_generator(PrngType type);
+    // Same rules as LT::set_code_graph, only RLF graphs are accepted
+    bool set_code_graph(std::shared_ptr<const CodeGraph> graph);
+    // Symbols [0, K) are the input symbols themselves, repair symbols
+    // K, K + 1, ... are the regular symbols 0, 1, ... Received inputs never
+    // enter elimination, only the missing columns are solved for
+    void set_systematic(bool systematic);
     void shuffle_input_symbols(bool discard = false);
+    void load_symbol(size_t number);
+
+    // Explicit coefficient mode, the packed row (row_words() words, bit n
+    // for input symbol n) travels with the symbol instead of its number, so
+    // relays may forward recoded combinations
+    size_t row_words() const;
+    void symbol_coefficients(size_t number, uint64_t* out);
 
     void feed_symbol(char* ptr, size_t number, bool deep_copy = false);
+    void feed_combination(char* ptr, const uint64_t* coefficients, bool deep_copy = false);
+    // Symbol is stored only if tag matches symbol_tag(), see crc32c.h.
+    // Returns whether the tag matched, as LT::feed_tagged_symbol does.
+    bool feed_tagged_symbol(char* ptr, size_t number, uint32_t tag, bool deep_copy = false);
+    // Sorts packets by symbol number so rows are generated in one forward
+    // sweep, then runs a single decode pass for the whole batch
+    bool feed_symbols(std::span<SymbolPacket> packets, bool deep_copy = false);
     bool decode(bool allow_partial = false);
+    void feed_source(char* ptr, size_t number, bool deep_copy);
+    bool decode_systematic(bool allow_partial);
 
+    // nullptr until decode() succeeded
     char* decoded_buffer();
+    // Rows and symbols are written as they are, partial elimination
+    // included, see snapshot.h for the layout. load_snapshot also feeds
+    // symbols appended after the snapshot, decode() is up to the caller.
+    bool save_snapshot(const std::string& path) const;
+    bool load_snapshot(const std::string& path);
+    const DecoderStats& stats() const;
+    DecoderStats& stats();
 
     void print_hash_matrix();
 
-    well_512 _generator;
+    uint64_t* acquire_row();
+    char* acquire_symbol();
+
+    Prng _generator;
+    std::shared_ptr<const CodeGraph> _graph;
     size_t _symbol_length = 0;
+    XorKernel _xor = xor_generic;
     size_t _input_symbols = 0;
+    size_t _row_words = 0;
     size_t _input_data_size = 0;
     char* _input_data = nullptr;
     bool _owner = false;
 
     std::vector<char*> _encoded_data;
     std::vector<bool> _encoded_data_copy;
-    std::vector<uint8_t*> _hash_bits;
-    std::vector<uint8_t> _current_hash_bits;
+    std::vector<uint64_t*> _hash_bits;
+    std::vector<uint64_t> _current_hash_bits;
+    std::vector<char*> _source_data;
+    std::vector<bool> _source_data_copy;
+    std::vector<char*> _solved;
+    std::vector<uint64_t*> _spare_rows;
+    std::vector<char*> _spare_symbols;
     size_t _current_symbol = 0;
+    // _current_hash_bits hold generated symbol _current_symbol - 1, graph
+    // and systematic symbols overwrite them without moving the generator
+    bool _hash_bits_generated = false;
+    size_t _next_symbol = 0;
+    uint32_t _seed = 0;
+    bool _systematic = false;
+    bool _streaming = false;
+    bool _decoded = false;
+
+    DecoderStats _stats;
 };
 } // namespace Fountain
 } // namespace Codes
\ No newline at end of file
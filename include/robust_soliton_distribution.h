@@ -17,6 +17,7 @@ public:
     void set_input_size(size_t input_symbols) override;
     size_t symbol_degree() override;
     std::vector<double> expected_distribution(size_t input_symbols) override;
+    std::string key() const override;
 
 private:
     well_512 _degree_dist;
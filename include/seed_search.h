@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "code_graph.h"
+#include "degree_distribution.h"
+#include "prng.h"
+
+namespace Codes::Fountain::SeedSearch {
+
+// Seeds are scored by simulating decoding on symbol indices only: RLF rows
+// go into an incremental GF(2) rank tracker, LT neighbor lists into an
+// incremental peeling decoder. Symbols arrive in number order, the loss free
+// run takes all of them, lossy trials drop each one with probability loss.
+// Trial t uses the same erasure pattern for every seed.
+struct Options
+{
+    double loss = 0.1;
+    size_t trials = 32;
+    // Decoding that needs more symbols counts as max_overhead + 1, 0 means K
+    size_t max_overhead = 0;
+    PrngType generator = PrngType::Well512;
+    size_t threads = std::thread::hardware_concurrency();
+};
+
+// Overhead is the number of symbols received beyond K when decoding finished
+struct Score
+{
+    uint32_t seed = 0;
+    size_t lossless_overhead = 0;
+    double mean_overhead = 0.0;
+    size_t max_overhead = 0;
+};
+
+// Every call gives a new distribution, LT takes ownership of it
+using DistributionFactory = std::function<DegreeDistribution*()>;
+
+Score score_rlf(uint32_t seed, size_t input_symbols, const Options& options = {});
+Score score_lt(const DistributionFactory& distribution, uint32_t seed, size_t input_symbols,
+               const Options& options = {});
+// Seeds [first, first + count) are scored in parallel, best first. Seed 0
+// is skipped, well_512 seeded with 0 only gives zeros.
+std::vector<Score> search_rlf(size_t input_symbols, uint32_t first, size_t count, const Options& options = {});
+std::vector<Score> search_lt(const DistributionFactory& distribution, size_t input_symbols, uint32_t first,
+                             size_t count, const Options& options = {});
+// Lower loss free overhead first, then lower mean and worst case
+bool better(const Score& lhs, const Score& rhs);
+
+struct Recommendation
+{
+    CodeGraph::Kind kind = CodeGraph::Kind::Rlf;
+    PrngType generator = PrngType::Well512;
+    // DegreeDistribution::key() of LT seeds, empty for RLF
+    const char* distribution = "";
+    size_t input_symbols = 0;
+    uint32_t seed = 0;
+    size_t lossless_overhead = 0;
+};
+
+// Seeds found with rateless_seed_search, only exact K matches are returned.
+// Below K = 128 no Well512 RLF seed reaches full rank with K + 0 symbols and
+// at K = 1024 none did within 2K, Xoshiro256 seeds reach K + 0 everywhere.
+std::optional<Recommendation> recommended_seed(CodeGraph::Kind kind, size_t input_symbols,
+                                               PrngType generator = PrngType::Well512,
+                                               const std::string& distribution = {});
+const std::vector<Recommendation>& recommendations();
+} // namespace Codes::Fountain::SeedSearch
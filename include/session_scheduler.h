@@ -0,0 +1,109 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "codec_feed.h"
+#include "thread_pool.h"
+
+namespace Codes::Fountain {
+
+// Type erased decoder driven by SessionScheduler
+class DecodeSession
+{
+public:
+    virtual ~DecodeSession() = default;
+    virtual void feed(std::unique_ptr<char[]> symbol, size_t number) = 0;
+    virtual bool decode() = 0;
+    virtual char* decoded_buffer() = 0;
+};
+
+template <typename Codec>
+class CodecSession : public DecodeSession
+{
+public:
+    explicit CodecSession(std::unique_ptr<Codec> codec)
+        : _codec(std::move(codec))
+    {}
+
+    void feed(std::unique_ptr<char[]> symbol, size_t number) override
+    {
+        feed_postponed(*_codec, symbol.release(), number, Memory::Owner);
+    }
+
+    bool decode() override
+    {
+        return _codec->decode();
+    }
+
+    char* decoded_buffer() override
+    {
+        return _codec->decoded_buffer();
+    }
+
+    Codec& codec()
+    {
+        return *_codec;
+    }
+
+private:
+    std::unique_ptr<Codec> _codec;
+};
+
+// Runs thousands of decode sessions on a shared work stealing pool.
+// Symbols are queued per session and a session task feeds at most
+// max_batch of them before a single decode pass. A session with more work
+// is posted again behind the others, so a large RLF block can not starve
+// small LT sessions.
+class SessionScheduler
+{
+public:
+    using Callback = std::function<void(size_t id, DecodeSession& session)>;
+
+    explicit SessionScheduler(size_t threads = std::thread::hardware_concurrency(), size_t max_batch = 64);
+    ~SessionScheduler();
+
+    // Future is true when session decoded, false when it was closed before.
+    // on_complete runs once on a pool thread, a close() issued while it runs
+    // does not change the result.
+    std::future<bool> open(size_t id, std::unique_ptr<DecodeSession> session, Callback on_complete = {});
+    bool submit(size_t id, const char* symbol, size_t symbol_length, size_t number);
+    void close(size_t id);
+    size_t sessions() const;
+
+private:
+    struct Packet
+    {
+        std::unique_ptr<char[]> data;
+        size_t number;
+    };
+
+    struct State
+    {
+        size_t id = 0;
+        std::mutex mutex;
+        std::vector<Packet> queue;
+        bool scheduled = false;
+        bool finished = false;
+        std::unique_ptr<DecodeSession> session;
+        std::promise<bool> promise;
+        Callback on_complete;
+    };
+
+    std::shared_ptr<State> find(size_t id) const;
+    void process(const std::shared_ptr<State>& state);
+    void finish(State& state, bool decoded);
+
+    size_t _max_batch = 0;
+    mutable std::shared_mutex _sessions_mutex;
+    std::unordered_map<size_t, std::shared_ptr<State>> _sessions;
+    ThreadPool _pool;
+};
+} // namespace Codes::Fountain
\ No newline at end of file
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "decoder_stats.h"
+#include "prng.h"
+#include "xor_kernel.h"
+
+namespace Codes::Fountain {
+
+// Sent along with every coded symbol, coefficients are derived from
+// (seed, number) so only the covered source range has to be transmitted
+struct WindowSymbol
+{
+    size_t number = 0;
+    size_t first = 0;
+    size_t count = 0;
+};
+
+// Sliding window random linear code over GF(2). Coded symbols combine
+// only the last `window` source symbols of an endless stream. The decoder
+// keeps its rows in reduced row echelon form over at most `capacity` live
+// columns, so a source symbol is released as soon as its row has a single
+// coefficient left, and in stream order through the delivery callback.
+// Sources that slid out of the encoder window unsolved, or the oldest ones
+// when a loss burst would exceed capacity, are given up and delivered as
+// nullptr, which bounds decoding latency.
+class SlidingWindowRLF
+{
+    enum class Slot : uint8_t
+    {
+        Empty,
+        Pivot,
+        Known
+    };
+
+public:
+    // Source symbols in order, data is nullptr for sources given up
+    using Delivery = std::function<void(size_t index, const char* data)>;
+
+    SlidingWindowRLF(size_t window, size_t symbol_length, size_t capacity = 0);
+
+    void set_seed(uint32_t seed);
+    void set_generator(PrngType type);
+
+    // Encoder
+    size_t push_source(const char* data);
+    WindowSymbol generate_symbol(char* out);
+    const char* source_symbol(size_t index) const;
+
+    // Decoder, both return true if the symbol added new information
+    void set_delivery(Delivery delivery);
+    bool feed_source(size_t index, const char* data);
+    bool feed_symbol(const char* data, const WindowSymbol& header);
+    size_t delivered() const;
+    size_t lost() const;
+    const DecoderStats& stats() const;
+
+private:
+    void load_coefficients(size_t number, size_t count);
+    bool feed_row(const char* data, size_t first, size_t count);
+    void solve(size_t column);
+    bool stalled(size_t column);
+    void give_up_stalled();
+    void give_up_oldest();
+    void deliver();
+    void release(size_t base);
+    uint64_t* row(size_t column);
+    char* payload(size_t column);
+
+    size_t _window = 0;
+    size_t _symbol_length = 0;
+    size_t _capacity = 0;
+    size_t _row_words = 0;
+    XorKernel _xor = xor_generic;
+    Prng _generator;
+    uint32_t _seed = 0;
+    std::vector<uint64_t> _current_hash_bits;
+
+    // encoder ring of the last window sources
+    std::vector<char> _sources;
+    size_t _pushed = 0;
+    size_t _next_symbol = 0;
+
+    // decoder columns [_base, _end), slot of column c is c % _capacity
+    std::vector<Slot> _slots;
+    // slot of a given up source, only read for released columns
+    std::vector<bool> _given_up;
+    std::vector<uint64_t> _rows;
+    std::vector<char> _payloads;
+    std::vector<uint64_t> _current_row;
+    std::vector<char> _current_payload;
+    size_t _base = 0;
+    size_t _end = 0;
+    size_t _horizon = 0;
+    size_t _delivered = 0;
+    size_t _lost = 0;
+    Delivery _delivery;
+
+    DecoderStats _stats;
+};
+} // namespace Codes::Fountain
\ No newline at end of file
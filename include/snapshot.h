@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+
+#include "decoder_stats.h"
+
+namespace Codes::Fountain::Snapshot {
+
+// On disk layout of a decoder snapshot, fixed width fields in host (little
+// endian) order, no padding or compression, so the file can be mapped:
+//   header, key (u32 length + bytes), decoder stats (u64 counters), codec
+//   state, then any number of appended symbols (u64 number + payload)
+//   received after the snapshot.
+// Appending a symbol is a single write, a full snapshot only has to be
+// taken once in a while.
+enum class Kind : uint32_t
+{
+    LT = 1,
+    RLF = 2
+};
+
+inline constexpr uint32_t magic = 0x4E534352; // "RCSN"
+inline constexpr uint32_t version = 2;
+inline constexpr uint32_t systematic_flag = 1;
+
+struct Header
+{
+    uint32_t magic = Snapshot::magic;
+    uint32_t version = Snapshot::version;
+    Kind kind = Kind::LT;
+    uint32_t seed = 0;
+    uint32_t generator = 0;
+    uint32_t flags = 0;
+    uint64_t data_size = 0;
+    uint64_t symbol_length = 0;
+};
+
+template <typename T>
+void write(std::ostream& out, const T& value)
+{
+    out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template <typename T>
+bool read(std::istream& in, T& value)
+{
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(value)));
+}
+
+void write_header(std::ostream& out, const Header& header, const std::string& key);
+// Fails on a foreign file, another version or kind, key is left for the caller to check
+bool read_header(std::istream& in, Kind kind, Header& header, std::string& key);
+// Counters and phase cycles, timers_enabled is left as it is
+void write_stats(std::ostream& out, const DecoderStats& stats);
+bool read_stats(std::istream& in, DecoderStats& stats);
+
+bool append_symbol(const std::string& path, uint64_t number, const char* data, size_t symbol_length);
+bool read_symbol(std::istream& in, size_t symbol_length, uint64_t& number, char* data);
+} // namespace Codes::Fountain::Snapshot
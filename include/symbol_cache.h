@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Codes::Fountain {
+
+class SymbolCache;
+
+// Zero copy view of a cached symbol, slot stays pinned until destruction
+class SymbolRef
+{
+public:
+    SymbolRef() = default;
+    SymbolRef(SymbolRef&& other) noexcept;
+    SymbolRef& operator=(SymbolRef&& other) noexcept;
+    ~SymbolRef();
+
+    const char* data() const;
+    size_t number() const;
+    explicit operator bool() const;
+
+private:
+    friend class SymbolCache;
+    void release();
+
+    std::atomic<uint32_t>* _pins = nullptr;
+    const char* _data = nullptr;
+    std::unique_ptr<char[]> _owned;
+    size_t _number = 0;
+};
+
+// Encoder side cache of generated symbols shared by many sessions.
+// Slots are grouped in sets of `ways`, symbol n maps to set n % sets and is
+// evicted with the clock (second chance) policy inside its set. Lookups are
+// lock free, only misses take the producer lock, so every symbol is produced
+// once while it stays cached no matter how many readers ask for it.
+class SymbolCache
+{
+public:
+    using Producer = std::function<void(size_t number, char* out)>;
+
+    SymbolCache(size_t capacity, size_t symbol_length, Producer producer, size_t ways = 4);
+
+    SymbolRef get(size_t number);
+    size_t symbol_length() const;
+    size_t capacity() const;
+    uint64_t hits() const;
+    uint64_t misses() const;
+
+private:
+    static constexpr uint64_t empty_slot = 0;
+    static constexpr uint64_t busy_slot = ~uint64_t(0);
+
+    struct Slot
+    {
+        std::atomic<uint64_t> key{empty_slot};
+        std::atomic<uint32_t> pins{0};
+        std::atomic<bool> referenced{false};
+    };
+
+    SymbolRef lookup(size_t number);
+    SymbolRef pin(Slot& slot, size_t idx, uint64_t key);
+
+    size_t _symbol_length = 0;
+    size_t _ways = 0;
+    size_t _sets = 0;
+    Producer _producer;
+    std::unique_ptr<Slot[]> _slots;
+    std::unique_ptr<char[]> _arena;
+    std::vector<size_t> _hands;
+    std::mutex _producer_mutex;
+    std::atomic<uint64_t> _hits{0};
+    std::atomic<uint64_t> _misses{0};
+};
+} // namespace Codes::Fountain
\ No newline at end of file
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+
+namespace Codes::Fountain {
+
+// One received encoded symbol, as handed over by a batched receive call
+struct SymbolPacket
+{
+    char* data = nullptr;
+    size_t number = 0;
+};
+} // namespace Codes::Fountain
\ No newline at end of file
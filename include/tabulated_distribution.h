@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "degree_distribution.h"
+#include "well512.h"
+
+namespace Codes::Fountain {
+// Degree probabilities given as a table, probabilities[d - 1] for degree d.
+// The table is normalised, mass of degrees above K goes to degree K.
+class TabulatedDistribution : public DegreeDistribution
+{
+public:
+    explicit TabulatedDistribution(std::vector<double> probabilities);
+    virtual ~TabulatedDistribution() = default;
+
+    // Text file with one "degree probability" pair per line, '#' starts a comment
+    static std::unique_ptr<TabulatedDistribution> load(const std::string& path);
+    bool save(const std::string& path) const;
+    const std::vector<double>& probabilities() const;
+
+    void set_seed(uint32_t seed) override;
+    void set_input_size(size_t input_symbols) override;
+    size_t symbol_degree() override;
+    std::vector<double> expected_distribution(size_t input_symbols) override;
+    std::string key() const override;
+
+private:
+    well_512 _degree_dist;
+    std::vector<double> _probabilities;
+    std::vector<double> _cumulative_probabilities;
+};
+} // namespace Codes::Fountain
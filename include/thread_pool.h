@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Codes::Fountain {
+
+// Work stealing pool. Every worker owns a FIFO deque, tasks posted from a
+// worker go to the back of its own deque, tasks posted from outside are
+// spread round robin. Idle workers steal from the back of other deques.
+class ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(size_t threads = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    void post(Task task);
+    size_t size() const;
+
+private:
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void run(size_t idx);
+    bool pop(size_t idx, Task& task);
+    bool steal(size_t idx, Task& task);
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::vector<std::thread> _threads;
+    std::atomic<size_t> _next{0};
+    std::atomic<size_t> _pending{0};
+    std::atomic<bool> _stop{false};
+    std::mutex _sleep_mutex;
+    std::condition_variable _wake;
+};
+} // namespace Codes::Fountain
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <cstring>
 #include <numeric>
@@ -13,6 +15,8 @@ struct well_512
         for (auto idx = 0u; idx < sizeof(state); idx += sizeof(seed))
             memcpy(state_mem + idx, &seed, sizeof(seed));
         index = 0;
+        bit_idx = sizeof(unsigned long) * 8;
+        bit_val = 0;
     }
 
     unsigned long state[16] = {0};
@@ -54,4 +58,66 @@ struct well_512
         ++bit_idx;
         return ret_val;
     }
+
+    void fill(uint64_t* out, size_t count)
+    {
+        for (size_t idx = 0; idx < count; ++idx)
+            out[idx] = operator()();
+    }
+
+    void fill_float(double* out, size_t count)
+    {
+        for (size_t idx = 0; idx < count; ++idx)
+            out[idx] = rand_float();
+    }
+
+    // Same bit stream as consecutive rand_bit() calls, bit n lands in out[n / 64] at position n % 64
+    void fill_bits(uint64_t* out, size_t bits)
+    {
+        constexpr size_t word_bits = sizeof(unsigned long) * 8;
+        auto words = bits / 64;
+        // on a word boundary every output word is exactly one generator word
+        if (word_bits == 64 && bit_idx == word_bits)
+            fill(out, words);
+        else
+            for (size_t idx = 0; idx < words; ++idx)
+                out[idx] = take_bits(64);
+        if (bits % 64)
+            out[words] = take_bits(bits % 64);
+    }
+
+    void discard_bits(size_t bits)
+    {
+        constexpr size_t word_bits = sizeof(unsigned long) * 8;
+        auto pending = std::min(bits, word_bits - bit_idx);
+        take_bits(pending);
+        bits -= pending;
+        for (; bits >= word_bits; bits -= word_bits)
+            operator()();
+        take_bits(bits);
+    }
+
+    uint64_t take_bits(size_t count)
+    {
+        constexpr size_t word_bits = sizeof(unsigned long) * 8;
+        uint64_t value = 0;
+        size_t filled = 0;
+        while (filled < count)
+        {
+            if (bit_idx == word_bits)
+            {
+                bit_val = operator()();
+                bit_idx = 0;
+            }
+            auto chunk = std::min(word_bits - bit_idx, count - filled);
+            uint64_t bits = bit_val;
+            if (chunk < 64)
+                bits &= (uint64_t(1) << chunk) - 1;
+            value |= bits << filled;
+            bit_val = chunk == word_bits ? 0 : bit_val >> chunk;
+            bit_idx += chunk;
+            filled += chunk;
+        }
+        return value;
+    }
 };
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+namespace Codes::Fountain {
+
+// dst ^= src over len bytes
+using XorKernel = void (*)(char* dst, const char* src, size_t len);
+
+// Trip count known at compile time, so the loop is fully unrolled and
+// vectorised. The len argument is ignored, it is there to match XorKernel.
+template <size_t Length>
+void xor_fixed(char* __restrict dst, const char* __restrict src, size_t)
+{
+    for (size_t idx = 0; idx < Length; ++idx)
+        dst[idx] ^= src[idx];
+}
+
+void xor_generic(char* dst, const char* src, size_t len);
+
+// Symbol lengths that get a xor_fixed instantiation
+inline constexpr size_t fixed_symbol_lengths[] = {1024, 1280, 4096};
+
+// Returns a specialised kernel for the symbol lengths listed in
+// fixed_symbol_lengths, xor_generic otherwise
+XorKernel select_xor_kernel(size_t symbol_length);
+} // namespace Codes::Fountain
\ No newline at end of file
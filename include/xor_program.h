@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "xor_kernel.h"
+
+namespace Codes::Fountain {
+
+// Straight line XOR program for a batch of encoded symbols. Planning is a
+// greedy common subexpression pass (as in XOR scheduling for Cauchy
+// Reed-Solomon): the pair of operands shared by most outputs becomes a
+// temporary, until no pair is shared twice or max_temporaries is reached.
+// Operand ids below input_symbols are input symbols, temporary t is id
+// input_symbols + t and only depends on operands defined before it.
+class XorProgram
+{
+public:
+    static XorProgram plan(std::span<const std::vector<uint32_t>> neighbor_sets, size_t input_symbols,
+                           size_t max_temporaries = 256);
+
+    size_t outputs() const;
+    size_t temporaries() const;
+    // Symbol XORs executed, a copy of the first operand is not counted
+    size_t xor_count() const;
+    // The same for encoding every output on its own
+    size_t naive_xor_count() const;
+
+    // Output n is written to out + n * symbol_length
+    void execute(const char* input, size_t symbol_length, XorKernel kernel, char* out,
+                 std::vector<char>& scratch) const;
+
+private:
+    struct Temporary
+    {
+        uint32_t lhs = 0;
+        uint32_t rhs = 0;
+    };
+
+    size_t _input_symbols = 0;
+    size_t _naive_xor_count = 0;
+    std::vector<Temporary> _temporaries;
+    std::vector<size_t> _offsets;
+    std::vector<uint32_t> _operands;
+};
+} // namespace Codes::Fountain
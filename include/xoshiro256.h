@@ -0,0 +1,149 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+// https://prng.di.unimi.it/xoshiro256starstar.c
+// Four independent xoshiro256** lanes kept in struct of arrays layout, so
+// the bulk loops vectorise (AVX2 holds all four lanes in one register).
+// Output stream interleaves lanes: lane 0, 1, 2, 3, lane 0, ...
+struct xoshiro_256
+{
+    static constexpr size_t lanes = 4;
+
+    uint64_t state[4][lanes] = {{0}};
+    uint64_t block[lanes] = {0};
+    size_t block_idx = lanes;
+
+    size_t bit_idx = 64;
+    uint64_t bit_val = 0;
+
+    void set_seed(uint32_t seed)
+    {
+        uint64_t mix = seed;
+        for (size_t lane = 0; lane < lanes; ++lane)
+            for (size_t word = 0; word < 4; ++word)
+                state[word][lane] = split_mix(mix);
+        block_idx = lanes;
+        bit_idx = 64;
+        bit_val = 0;
+    }
+
+    static uint64_t split_mix(uint64_t& value)
+    {
+        auto z = (value += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    static uint64_t rotl(uint64_t value, int shift)
+    {
+        return (value << shift) | (value >> (64 - shift));
+    }
+
+    void next_block(uint64_t* out)
+    {
+        for (size_t lane = 0; lane < lanes; ++lane)
+        {
+            out[lane] = rotl(state[1][lane] * 5, 7) * 9;
+            auto t = state[1][lane] << 17;
+            state[2][lane] ^= state[0][lane];
+            state[3][lane] ^= state[1][lane];
+            state[1][lane] ^= state[2][lane];
+            state[0][lane] ^= state[3][lane];
+            state[2][lane] ^= t;
+            state[3][lane] = rotl(state[3][lane], 45);
+        }
+    }
+
+    uint64_t operator()()
+    {
+        if (block_idx == lanes)
+        {
+            next_block(block);
+            block_idx = 0;
+        }
+        return block[block_idx++];
+    }
+
+    double rand_float()
+    {
+        return double(operator()() >> 11) * 0x1.0p-53;
+    }
+
+    uint8_t rand_bit()
+    {
+        if (bit_idx == 64)
+        {
+            bit_val = operator()();
+            bit_idx = 0;
+        }
+        auto ret_val = uint8_t(bit_val & 0x01);
+        bit_val >>= 1;
+        ++bit_idx;
+        return ret_val;
+    }
+
+    void fill(uint64_t* out, size_t count)
+    {
+        size_t idx = 0;
+        for (; idx < count && block_idx != lanes; ++idx)
+            out[idx] = operator()();
+        for (; idx + lanes <= count; idx += lanes)
+            next_block(out + idx);
+        for (; idx < count; ++idx)
+            out[idx] = operator()();
+    }
+
+    void fill_float(double* out, size_t count)
+    {
+        for (size_t idx = 0; idx < count; ++idx)
+            out[idx] = rand_float();
+    }
+
+    // Same bit stream as consecutive rand_bit() calls, bit n lands in out[n / 64] at position n % 64
+    void fill_bits(uint64_t* out, size_t bits)
+    {
+        auto words = bits / 64;
+        if (bit_idx == 64)
+            fill(out, words);
+        else
+            for (size_t idx = 0; idx < words; ++idx)
+                out[idx] = take_bits(64);
+        if (bits % 64)
+            out[words] = take_bits(bits % 64);
+    }
+
+    void discard_bits(size_t bits)
+    {
+        auto pending = std::min(bits, 64 - bit_idx);
+        take_bits(pending);
+        bits -= pending;
+        for (; bits >= 64; bits -= 64)
+            operator()();
+        take_bits(bits);
+    }
+
+    uint64_t take_bits(size_t count)
+    {
+        uint64_t value = 0;
+        size_t filled = 0;
+        while (filled < count)
+        {
+            if (bit_idx == 64)
+            {
+                bit_val = operator()();
+                bit_idx = 0;
+            }
+            auto chunk = std::min(64 - bit_idx, count - filled);
+            auto bits = chunk == 64 ? bit_val : bit_val & ((uint64_t(1) << chunk) - 1);
+            value |= bits << filled;
+            bit_val = chunk == 64 ? 0 : bit_val >> chunk;
+            bit_idx += chunk;
+            filled += chunk;
+        }
+        return value;
+    }
+};
@@ -0,0 +1,72 @@
+#include "ingestor.h"
+#include "robust_soliton_distribution.h"
+
+#include <thread>
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+
+using namespace testing;
+
+TEST(Ingestor, MultipleReceiveThreads)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto symbol_length = 16u;
+    auto input_symbols = 2000u;
+    auto total_data_size = symbol_length * input_symbols;
+    auto seed = 13u;
+    auto receivers = 4u;
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 7 + 1);
+
+    LT decoder(new RobustSolitonDistribution(0.05, 0.03));
+    decoder.set_seed(seed);
+    decoder.set_input_data_size(total_data_size);
+    decoder.set_symbol_length(symbol_length);
+    Ingestor ingestor(decoder, symbol_length, 256, 32);
+
+    // every receiver thread (NIC queue) encodes its own share of symbol ids
+    std::vector<std::thread> threads;
+    for (auto receiver = 0u; receiver < receivers; ++receiver)
+    {
+        threads.emplace_back([&, receiver] {
+            LT encoder(new RobustSolitonDistribution(0.05, 0.03));
+            encoder.set_seed(seed);
+            encoder.set_input_data(data.data(), data.size());
+            encoder.set_symbol_length(symbol_length);
+            std::vector<char> symbol(symbol_length);
+            for (auto number = receiver; !ingestor.done() && number < 4 * input_symbols; number += receivers)
+            {
+                encoder.generate_symbol(number, symbol.data());
+                while (!ingestor.push(symbol.data(), number) && !ingestor.done())
+                    std::this_thread::yield();
+            }
+        });
+    }
+    ASSERT_TRUE(ingestor.completed().get());
+    for (auto& thread : threads)
+        thread.join();
+    ingestor.stop();
+
+    std::unique_ptr<char[]> payload(decoder.decoded_buffer());
+    EXPECT_EQ(memcmp(payload.get(), data.data(), total_data_size), 0);
+}
+
+TEST(Ingestor, StopBeforeComplete)
+{
+    using namespace Codes::Fountain;
+    RLF decoder;
+    decoder.set_seed(13);
+    decoder.set_input_data_size(100);
+    decoder.set_symbol_length(10);
+    Ingestor ingestor(decoder, 10, 8);
+    std::vector<char> symbol(10, 1);
+    for (auto number = 0u; number < 8; ++number)
+        ingestor.push(symbol.data(), number);
+    ingestor.stop();
+    EXPECT_FALSE(ingestor.completed().get());
+    EXPECT_FALSE(ingestor.push(symbol.data(), 9));
+}
\ No newline at end of file
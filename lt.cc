@@ -1,7 +1,12 @@
 #include "lt.h"
+#include "code_graph.h"
+#include "decoder_pool.h"
+#include "capped_distribution.h"
 #include "ideal_soliton_distribution.h"
 #include "robust_soliton_distribution.h"
+#include "well512.h"
 
+#include <filesystem>
 #include <numeric>
 #include <span>
 
@@ -443,3 +448,668 @@ TEST(LT, EncodeOnTheFlyRobustSolition)
     spdlog::debug("Iteration time {:.2f}ms, Avg/dev: {:.3f}/{:.3f}", double(duration.count()) / 1000.0 / retries_max,
                   average_symbol_num, average_symbol_dev);
 }
+
+TEST(LT, DecoderStats)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto symbol_length = 4u;
+    auto seed = 13u;
+    auto total_data_size = 4000u;
+    auto input_symbols = total_data_size / symbol_length;
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 7);
+
+    LT encoder(new RobustSolitonDistribution(0.05, 0.03));
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    LT decoder(new RobustSolitonDistribution(0.05, 0.03));
+    decoder.set_seed(seed);
+    decoder.set_input_data_size(total_data_size);
+    decoder.set_symbol_length(symbol_length);
+    decoder.stats().enable_timers(true);
+
+    auto enc_num = 0u;
+    while (!decoder.feed_symbol(encoder.generate_symbol(), enc_num, Memory::Owner, Decoding::Start))
+        ++enc_num;
+    decoder.feed_symbol(encoder.generate_symbol(), ++enc_num, Memory::Owner, Decoding::Start);
+
+    const auto& stats = decoder.stats();
+    EXPECT_EQ(stats.symbols_received, enc_num + 1);
+    EXPECT_EQ(stats.redundant_symbols, 1u);
+    EXPECT_EQ(stats.peeling_steps, input_symbols);
+    EXPECT_GT(stats.bytes_xored, 0u);
+    EXPECT_EQ(stats.bytes_xored % symbol_length, 0u);
+    EXPECT_GE(stats.ripple_high_water, 1u);
+    EXPECT_GT(stats.cycles(Phase::Feed), 0u);
+    EXPECT_GT(stats.cycles(Phase::Peel), 0u);
+
+    auto text = stats.to_text("lt");
+    EXPECT_THAT(text, HasSubstr(fmt::format("lt_symbols_received {}\n", enc_num + 1)));
+    EXPECT_THAT(text, HasSubstr(fmt::format("lt_peeling_steps {}\n", input_symbols)));
+    EXPECT_THAT(text, HasSubstr("lt_peel_cycles "));
+}
+
+TEST(LT, RingBufferObserver)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto symbol_length = 2u;
+    auto seed = 13u;
+    auto total_data_size = 200u;
+    auto input_symbols = total_data_size / symbol_length;
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx);
+
+    LT encoder(new RobustSolitonDistribution(0.05, 0.03));
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    BasicLT<RingBufferObserver> decoder(new RobustSolitonDistribution(0.05, 0.03));
+    decoder.observer().resize(1 << 12);
+    decoder.set_seed(seed);
+    decoder.set_input_data_size(total_data_size);
+    decoder.set_symbol_length(symbol_length);
+
+    auto enc_num = 0u;
+    while (!decoder.feed_symbol(encoder.generate_symbol(), enc_num, Memory::Owner, Decoding::Start))
+        ++enc_num;
+
+    auto events = decoder.observer().events();
+    ASSERT_EQ(events.size(), decoder.observer().total());
+    auto count = [&events](DecoderEventType type) {
+        return std::count_if(events.begin(), events.end(), [type](const auto& ev) { return ev.type == type; });
+    };
+    EXPECT_EQ(count(DecoderEventType::SymbolFed), enc_num + 1);
+    EXPECT_EQ(count(DecoderEventType::InputDecoded), input_symbols);
+    EXPECT_GE(count(DecoderEventType::SymbolReleased), input_symbols);
+    EXPECT_GT(count(DecoderEventType::RippleEmpty), 0);
+    auto last_decoded = std::find_if(events.rbegin(), events.rend(),
+                                     [](const auto& ev) { return ev.type == DecoderEventType::InputDecoded; });
+    EXPECT_EQ(last_decoded->value, 0u);
+
+    decoder.observer().resize(4);
+    decoder.observer().ripple_empty(1);
+    decoder.observer().ripple_empty(2);
+    decoder.observer().ripple_empty(3);
+    decoder.observer().ripple_empty(4);
+    decoder.observer().ripple_empty(5);
+    events = decoder.observer().events();
+    ASSERT_EQ(events.size(), 4u);
+    EXPECT_EQ(events.front().value, 2u);
+    EXPECT_EQ(events.back().value, 5u);
+
+    // values are kept at full width
+    decoder.observer().ripple_empty(size_t{1} << 40);
+    EXPECT_EQ(decoder.observer().events().back().value, uint64_t{1} << 40);
+}
+
+namespace {
+// Not one of the built-in observers, BasicLT is instantiated from lt.ipp
+struct CountingObserver
+{
+    void symbol_fed(size_t, size_t)
+    {
+        ++fed;
+    }
+    void symbol_released(size_t, size_t) {}
+    void input_decoded(size_t, size_t)
+    {
+        ++decoded;
+    }
+    void ripple_empty(size_t) {}
+
+    size_t fed = 0;
+    size_t decoded = 0;
+};
+} // namespace
+
+TEST(LT, UserObserver)
+{
+    using namespace Codes::Fountain;
+    auto symbol_length = 4u;
+    auto input_symbols = 64u;
+    auto seed = 13u;
+    std::vector<char> data(symbol_length * input_symbols);
+    for (auto idx = 0u; idx < data.size(); ++idx)
+        data[idx] = static_cast<char>(idx * 7 + 3);
+
+    LT encoder(new RobustSolitonDistribution(0.05, 0.03));
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+    BasicLT<CountingObserver> decoder(new RobustSolitonDistribution(0.05, 0.03));
+    decoder.set_seed(seed);
+    decoder.set_input_data_size(data.size());
+    decoder.set_symbol_length(symbol_length);
+
+    std::vector<char> symbol(symbol_length);
+    auto number = 0u;
+    for (; number < 4 * input_symbols; ++number)
+    {
+        encoder.generate_symbol(number, symbol.data());
+        if (decoder.feed_symbol(symbol.data(), number))
+            break;
+    }
+    EXPECT_EQ(decoder.observer().fed, number + 1);
+    EXPECT_EQ(decoder.observer().decoded, input_symbols);
+}
+
+TEST(XorKernel, FixedMatchesGeneric)
+{
+    using namespace Codes::Fountain;
+    std::vector<size_t> lengths(std::begin(fixed_symbol_lengths), std::end(fixed_symbol_lengths));
+    lengths.insert(lengths.end(), {13, 1000});
+    for (auto symbol_length : lengths)
+    {
+        std::vector<char> src(symbol_length);
+        std::vector<char> expected(symbol_length);
+        for (auto idx = 0u; idx < symbol_length; ++idx)
+        {
+            src[idx] = static_cast<char>(idx * 13);
+            expected[idx] = static_cast<char>(idx * 7);
+        }
+        auto dst = expected;
+        for (auto idx = 0u; idx < symbol_length; ++idx)
+            expected[idx] ^= src[idx];
+        select_xor_kernel(symbol_length)(dst.data(), src.data(), symbol_length);
+        EXPECT_THAT(dst, Eq(expected));
+    }
+    for (auto symbol_length : fixed_symbol_lengths)
+        EXPECT_NE(select_xor_kernel(symbol_length), &xor_generic) << symbol_length;
+    EXPECT_NE(select_xor_kernel(1280), select_xor_kernel(1024));
+    EXPECT_EQ(select_xor_kernel(1000), &xor_generic);
+}
+
+TEST(LT, EncodeFixedSymbolLength)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto symbol_length = 1280u;
+    auto input_symbols = 64u;
+    auto total_data_size = symbol_length * input_symbols;
+    auto seed = 13u;
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 11);
+
+    LT encoder(new RobustSolitonDistribution(0.05, 0.03));
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    LT decoder(new RobustSolitonDistribution(0.05, 0.03));
+    decoder.set_seed(seed);
+    decoder.set_input_data_size(total_data_size);
+    decoder.set_symbol_length(symbol_length);
+
+    auto enc_num = 0u;
+    while (!decoder.feed_symbol(encoder.generate_symbol(), enc_num, Memory::Owner, Decoding::Start))
+        ++enc_num;
+    std::unique_ptr<char[]> payload(decoder.decoded_buffer());
+    std::vector<char> decoded(payload.get(), payload.get() + total_data_size);
+    ASSERT_THAT(decoded, Eq(data));
+}
+
+TEST(LT, SharedCodeGraph)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto symbol_length = 4u;
+    auto input_symbols = 500u;
+    auto graph_symbols = 400u;
+    auto total_data_size = symbol_length * input_symbols;
+    auto seed = 13u;
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 11);
+
+    auto graph =
+        CodeGraphCache::instance().lt(new RobustSolitonDistribution(0.05, 0.03), seed, input_symbols, graph_symbols);
+    EXPECT_EQ(graph, CodeGraphCache::instance().lt(new RobustSolitonDistribution(0.05, 0.03), seed, input_symbols,
+                                                   graph_symbols));
+    EXPECT_NE(graph, CodeGraphCache::instance().lt(new RobustSolitonDistribution(0.05, 0.04), seed, input_symbols,
+                                                   graph_symbols));
+    EXPECT_EQ(graph->symbols(), graph_symbols);
+
+    LT plain(new RobustSolitonDistribution(0.05, 0.03));
+    plain.set_seed(seed);
+    plain.set_input_data(data.data(), data.size());
+    plain.set_symbol_length(symbol_length);
+
+    LT encoder(new RobustSolitonDistribution(0.05, 0.03));
+    encoder.set_code_graph(graph);
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    LT decoder(new RobustSolitonDistribution(0.05, 0.03));
+    decoder.set_code_graph(graph);
+    decoder.set_seed(seed);
+    decoder.set_input_data_size(total_data_size);
+    decoder.set_symbol_length(symbol_length);
+
+    // symbols past the graph have to match too, start losing packets there
+    auto enc_num = 0u;
+    auto decoded = false;
+    while (!decoded)
+    {
+        std::unique_ptr<char[]> expected(plain.generate_symbol());
+        auto* symbol = encoder.generate_symbol();
+        ASSERT_EQ(memcmp(expected.get(), symbol, symbol_length), 0) << enc_num;
+        if (enc_num < graph_symbols || enc_num % 3)
+            decoded = decoder.feed_symbol(symbol, enc_num, Memory::Owner, Decoding::Start);
+        else
+            delete[] symbol;
+        ++enc_num;
+    }
+    EXPECT_GT(enc_num, graph_symbols);
+    std::unique_ptr<char[]> payload(decoder.decoded_buffer());
+    ASSERT_EQ(memcmp(payload.get(), data.data(), total_data_size), 0);
+    CodeGraphCache::instance().clear();
+}
+
+TEST(LT, RejectsMismatchedCodeGraph)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto input_symbols = 64u;
+    auto graph = CodeGraph::build_lt(new RobustSolitonDistribution(0.05, 0.03), 13u, input_symbols, 100);
+
+    LT codec(new RobustSolitonDistribution(0.05, 0.03));
+    codec.set_seed(13u);
+    codec.set_input_data_size(input_symbols);
+    codec.set_symbol_length(1);
+    EXPECT_FALSE(codec.set_code_graph(CodeGraph::build_rlf(13u, input_symbols, 100)));
+    EXPECT_FALSE(codec.set_code_graph(
+        CodeGraph::build_lt(new RobustSolitonDistribution(0.05, 0.03), 13u, input_symbols / 2, 100)));
+    EXPECT_FALSE(LT(new RobustSolitonDistribution(0.05, 0.04)).set_code_graph(graph));
+    EXPECT_TRUE(codec.set_code_graph(graph));
+
+    // attached before the seed is known, a graph of another seed is skipped
+    LT plain(new RobustSolitonDistribution(0.05, 0.03));
+    plain.set_seed(14u);
+    plain.set_input_data_size(input_symbols);
+    plain.set_symbol_length(1);
+    LT other(new RobustSolitonDistribution(0.05, 0.03));
+    EXPECT_TRUE(other.set_code_graph(graph));
+    other.set_seed(14u);
+    other.set_input_data_size(input_symbols);
+    other.set_symbol_length(1);
+    for (auto number = 0u; number < 100; ++number)
+    {
+        plain.load_symbol(number);
+        other.load_symbol(number);
+        ASSERT_THAT(other._current_hash_bits, Eq(plain._current_hash_bits)) << number;
+    }
+}
+
+// Written against DegreeDistribution without overriding key()
+class UniformDegreeDistribution : public Codes::Fountain::DegreeDistribution
+{
+public:
+    explicit UniformDegreeDistribution(size_t max_degree)
+        : _max_degree(max_degree)
+    {}
+
+    void set_seed(uint32_t seed) override
+    {
+        _generator.set_seed(seed);
+    }
+    void set_input_size(size_t input_symbols) override
+    {
+        _degrees = std::min(_max_degree, input_symbols);
+    }
+    size_t symbol_degree() override
+    {
+        return 1 + _generator() % _degrees;
+    }
+    std::vector<double> expected_distribution(size_t input_symbols) override
+    {
+        std::vector<double> expected(input_symbols, 0.0);
+        auto degrees = std::min(_max_degree, input_symbols);
+        std::fill_n(expected.begin(), degrees, 1.0 / static_cast<double>(degrees));
+        return expected;
+    }
+
+private:
+    size_t _max_degree = 0;
+    size_t _degrees = 1;
+    well_512 _generator;
+};
+
+TEST(LT, DistributionWithoutKey)
+{
+    using namespace Codes::Fountain;
+    auto symbol_length = 16u;
+    auto input_symbols = 64u;
+    auto burst = 32u;
+    std::vector<char> data(symbol_length * input_symbols);
+    for (auto idx = 0u; idx < data.size(); ++idx)
+        data[idx] = static_cast<char>(idx * 5 + 1);
+
+    EXPECT_FALSE(UniformDegreeDistribution(4).cacheable());
+    EXPECT_FALSE(CappedDistribution(new UniformDegreeDistribution(4), 2).cacheable());
+    EXPECT_TRUE(RobustSolitonDistribution(0.05, 0.03).cacheable());
+    EXPECT_TRUE(CappedDistribution(new RobustSolitonDistribution(0.05, 0.03), 2).cacheable());
+
+    // parameters are unknown, so graphs are neither shared nor attached
+    auto& cache = CodeGraphCache::instance();
+    cache.clear();
+    auto graph = cache.lt(new UniformDegreeDistribution(4), 13u, input_symbols, 100);
+    EXPECT_NE(graph, cache.lt(new UniformDegreeDistribution(4), 13u, input_symbols, 100));
+    EXPECT_EQ(cache.size(), 0u);
+    LT encoder(new UniformDegreeDistribution(4));
+    EXPECT_FALSE(encoder.set_code_graph(graph));
+
+    // and every batch is planned again
+    encoder.set_seed(13u);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+    std::vector<char> batch(burst * symbol_length);
+    std::vector<char> single(burst * symbol_length);
+    for (auto round = 0u; round < 2; ++round)
+    {
+        encoder._batch_sets.clear();
+        encoder.generate_symbols(0, burst, batch.data());
+        EXPECT_EQ(encoder._batch_sets.size(), burst);
+    }
+    for (auto idx = 0u; idx < burst; ++idx)
+        encoder.generate_symbol(idx, single.data() + idx * symbol_length);
+    EXPECT_EQ(batch, single);
+}
+
+TEST(LT, ReloadSameSymbol)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto input_symbols = 64u;
+    LT plain(new RobustSolitonDistribution(0.05, 0.03));
+    plain.set_seed(13u);
+    plain.set_input_data_size(input_symbols);
+    plain.set_symbol_length(1);
+    LT codec(new RobustSolitonDistribution(0.05, 0.03));
+    codec.set_code_graph(CodeGraph::build_lt(new RobustSolitonDistribution(0.05, 0.03), 13u, input_symbols, 10));
+    codec.set_seed(13u);
+    codec.set_input_data_size(input_symbols);
+    codec.set_symbol_length(1);
+
+    plain.load_symbol(20);
+    codec.load_symbol(20);
+    // a rewind would regenerate from the changed seed
+    codec._seed = 14u;
+    codec.load_symbol(20);
+    EXPECT_THAT(codec._current_hash_bits, Eq(plain._current_hash_bits));
+    codec._seed = 13u;
+
+    // graph symbol in between overwrites the neighbours, reload has to rewind
+    codec.load_symbol(3);
+    codec.load_symbol(20);
+    EXPECT_THAT(codec._current_hash_bits, Eq(plain._current_hash_bits));
+    plain.load_symbol(21);
+    codec.load_symbol(21);
+    EXPECT_THAT(codec._current_hash_bits, Eq(plain._current_hash_bits));
+}
+
+TEST(LT, ResetReusesDecoder)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    DecoderPool<LT> pool([] { return new LT(new RobustSolitonDistribution(0.05, 0.03)); }, 2);
+
+    // same shape twice to reuse buffers, then a different one
+    for (auto [symbol_length, input_symbols] : {std::pair{4u, 300u}, std::pair{4u, 300u}, std::pair{8u, 100u}})
+    {
+        auto total_data_size = symbol_length * input_symbols;
+        auto seed = 13u + symbol_length + input_symbols;
+        std::vector<char> data(total_data_size);
+        for (auto idx = 0u; idx < total_data_size; ++idx)
+            data[idx] = static_cast<char>(idx * 3 + seed);
+
+        LT encoder(new RobustSolitonDistribution(0.05, 0.03));
+        encoder.set_seed(seed);
+        encoder.set_input_data(data.data(), data.size());
+        encoder.set_symbol_length(symbol_length);
+
+        auto decoder = pool.acquire(seed, total_data_size, symbol_length);
+        EXPECT_EQ(decoder->stats().symbols_received, 0u);
+        auto enc_num = 0u;
+        auto decoded = false;
+        std::vector<char> symbol(symbol_length);
+        while (!decoded)
+        {
+            encoder.generate_symbol(enc_num, symbol.data());
+            decoded = decoder->feed_symbol(symbol.data(), enc_num++, Memory::MakeCopy);
+        }
+        std::unique_ptr<char[]> payload(decoder->decoded_buffer());
+        ASSERT_EQ(memcmp(payload.get(), data.data(), total_data_size), 0);
+        EXPECT_EQ(pool.idle(), 0u);
+    }
+    EXPECT_EQ(pool.idle(), 1u);
+}
+
+TEST(LT, ResetBoundsSpareBuffers)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto input_symbols = 100u;
+    auto seed = 13u;
+    std::vector<char> data(input_symbols);
+    for (auto idx = 0u; idx < data.size(); ++idx)
+        data[idx] = static_cast<char>(idx * 3 + 1);
+    LT encoder(new RobustSolitonDistribution(0.05, 0.03));
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(1);
+
+    BasicLT<RingBufferObserver> decoder(new RobustSolitonDistribution(0.05, 0.03));
+    decoder.reset(seed, data.size(), 1);
+    for (auto round = 0u; round < 3; ++round)
+    {
+        // every buffer comes from the caller, none is ever taken back
+        auto decoded = false;
+        for (auto number = 0u; !decoded; ++number)
+        {
+            auto* symbol = new char[1];
+            encoder.generate_symbol(number, symbol);
+            decoded = decoder.feed_symbol(symbol, number, Memory::Owner);
+        }
+        EXPECT_GT(decoder.observer().total(), 0u);
+        decoder.reset(seed, data.size(), 1);
+        EXPECT_LE(decoder._spare_buffers.size(), input_symbols);
+        EXPECT_EQ(decoder.observer().total(), 0u);
+    }
+    decoder.reset(seed, data.size() / 2, 1);
+    EXPECT_LE(decoder._spare_buffers.size(), input_symbols / 2);
+}
+
+TEST(LT, FeedSymbolsBatches)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto symbol_length = 8u;
+    auto input_symbols = 1000u;
+    auto total_data_size = symbol_length * input_symbols;
+    auto seed = 13u;
+    auto batch_size = 48u;
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 11);
+
+    LT encoder(new RobustSolitonDistribution(0.05, 0.03));
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    LT decoder(new RobustSolitonDistribution(0.05, 0.03));
+    decoder.set_seed(seed);
+    decoder.set_input_data_size(total_data_size);
+    decoder.set_symbol_length(symbol_length);
+
+    // batches arrive reordered and every 7th symbol is lost
+    std::vector<std::vector<char>> symbols;
+    std::vector<SymbolPacket> batch;
+    auto decoded = false;
+    for (auto first = 0u; !decoded && first < 4 * input_symbols; first += batch_size)
+    {
+        batch.clear();
+        for (auto number = first + batch_size; number-- > first;)
+        {
+            if (number % 7 == 3)
+                continue;
+            symbols.emplace_back(symbol_length);
+            encoder.generate_symbol(number, symbols.back().data());
+            batch.push_back({symbols.back().data(), number});
+        }
+        decoded = decoder.feed_symbols(batch);
+    }
+    ASSERT_TRUE(decoded);
+    std::unique_ptr<char[]> payload(decoder.decoded_buffer());
+    std::vector<char> result(payload.get(), payload.get() + total_data_size);
+    ASSERT_THAT(result, Eq(data));
+}
+
+TEST(LT, StreamDecodedPrefix)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto symbol_length = 8u;
+    auto input_symbols = 1000u;
+    auto total_data_size = symbol_length * input_symbols;
+    auto seed = 13u;
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 11);
+
+    LT encoder(new RobustSolitonDistribution(0.05, 0.03));
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    BasicLT<ProgressObserver> decoder(new RobustSolitonDistribution(0.05, 0.03));
+    decoder.set_seed(seed);
+    decoder.set_input_data_size(total_data_size);
+    decoder.set_symbol_length(symbol_length);
+
+    // consumer copies the prefix out as soon as it grows
+    std::vector<char> consumed;
+    std::vector<size_t> recovered(input_symbols);
+    std::vector<char> symbol(symbol_length);
+    size_t recovered_early = 0;
+    auto progress_steps = 0u;
+    for (auto number = 0u; number < 4 * input_symbols; ++number)
+    {
+        encoder.generate_symbol(number, symbol.data());
+        auto decoded = decoder.feed_symbol(symbol.data(), number);
+        auto inputs = decoder.observer().take();
+        if (!inputs.empty())
+            ++progress_steps;
+        for (auto input : inputs)
+            ++recovered[input];
+        for (auto idx = consumed.size() / symbol_length; idx < decoder.decoded_prefix(); ++idx)
+        {
+            auto* input = decoder.input_symbol(idx);
+            ASSERT_NE(input, nullptr);
+            consumed.insert(consumed.end(), input, input + symbol_length);
+        }
+        if (decoded)
+            break;
+        recovered_early += inputs.size();
+    }
+    EXPECT_GT(recovered_early, 0u);
+    EXPECT_GT(progress_steps, 1u);
+    EXPECT_EQ(decoder.decoded_prefix(), input_symbols);
+    EXPECT_THAT(recovered, Each(1u));
+    ASSERT_THAT(consumed, Eq(data));
+}
+
+TEST(LT, SystematicLossyLink)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto symbol_length = 8u;
+    auto input_symbols = 1000u;
+    auto total_data_size = symbol_length * input_symbols;
+    auto seed = 13u;
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 11 + 1);
+
+    LT encoder(new RobustSolitonDistribution(0.05, 0.03));
+    encoder.set_systematic(true);
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    LT decoder(new RobustSolitonDistribution(0.05, 0.03));
+    decoder.set_systematic(true);
+    decoder.set_seed(seed);
+    decoder.set_input_data_size(total_data_size);
+    decoder.set_symbol_length(symbol_length);
+
+    // every 100th symbol is lost
+    std::vector<char> symbol(symbol_length);
+    auto decoded = false;
+    auto number = 0u;
+    for (; !decoded && number < 3 * input_symbols; ++number)
+    {
+        encoder.generate_symbol(number, symbol.data());
+        if (number % 100 == 42)
+            continue;
+        decoded = decoder.feed_symbol(symbol.data(), number);
+    }
+    ASSERT_TRUE(decoded);
+    EXPECT_GT(number, input_symbols);
+    std::unique_ptr<char[]> payload(decoder.decoded_buffer());
+    std::vector<char> result(payload.get(), payload.get() + total_data_size);
+    ASSERT_THAT(result, Eq(data));
+}
+
+TEST(LT, MemoryBudgetSpilling)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto symbol_length = 64u;
+    auto input_symbols = 2000u;
+    auto total_data_size = symbol_length * input_symbols;
+    auto seed = 13u;
+    auto budget = 100u * symbol_length;
+    auto scratch = (std::filesystem::temp_directory_path() / "rateless_codes_lt_spill.bin").string();
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 11 + 5);
+
+    LT encoder(new RobustSolitonDistribution(0.05, 0.03));
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    LT decoder(new RobustSolitonDistribution(0.05, 0.03));
+    ASSERT_TRUE(decoder.set_memory_budget(budget, scratch));
+    decoder.set_seed(seed);
+    decoder.set_input_data_size(total_data_size);
+    decoder.set_symbol_length(symbol_length);
+
+    std::vector<char> symbol(symbol_length);
+    auto max_spilled = size_t{0};
+    auto decoded = false;
+    for (auto number = 0u; !decoded && number < 3 * input_symbols; ++number)
+    {
+        encoder.generate_symbol(number, symbol.data());
+        decoded = decoder.feed_symbol(symbol.data(), number);
+        max_spilled = std::max(max_spilled, decoder.spilled_symbols());
+        ASSERT_LE(decoder._resident_bytes, budget);
+    }
+    ASSERT_TRUE(decoded);
+    EXPECT_GT(max_spilled, input_symbols / 2);
+    std::unique_ptr<char[]> payload(decoder.decoded_buffer());
+    std::vector<char> result(payload.get(), payload.get() + total_data_size);
+    ASSERT_THAT(result, Eq(data));
+    decoder.set_memory_budget(0, scratch);
+    std::filesystem::remove(scratch);
+}
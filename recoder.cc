@@ -0,0 +1,99 @@
+#include "recoder.h"
+#include "rlf.h"
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+
+using namespace testing;
+
+TEST(Recoder, TwoHopRelay)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto symbol_length = 16u;
+    auto input_symbols = 100u;
+    auto total_data_size = symbol_length * input_symbols;
+    auto seed = 13u;
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 7 + 3);
+
+    RLF encoder;
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    // first relay loses every third source symbol, second relay only hears
+    // the first one and forwards recoded symbols to the receiver
+    Recoder first(input_symbols, symbol_length, 2 * input_symbols);
+    first.set_seed(1);
+    Recoder second(input_symbols, symbol_length, 2 * input_symbols);
+    second.set_seed(2);
+    std::vector<char> symbol(symbol_length);
+    std::vector<uint64_t> coefficients(encoder.row_words());
+    for (auto number = 0u; number < 2 * input_symbols; ++number)
+    {
+        if (number % 3 == 0)
+            continue;
+        encoder.generate_symbol(number, symbol.data());
+        encoder.symbol_coefficients(number, coefficients.data());
+        ASSERT_TRUE(first.add_symbol(symbol.data(), coefficients.data()));
+    }
+    for (auto idx = 0u; idx < 2 * input_symbols; ++idx)
+    {
+        ASSERT_TRUE(first.recode(symbol.data(), coefficients.data()));
+        second.add_symbol(symbol.data(), coefficients.data());
+    }
+
+    RLF decoder;
+    decoder.set_input_data_size(total_data_size);
+    decoder.set_symbol_length(symbol_length);
+    ASSERT_EQ(decoder.row_words(), second.row_words());
+    auto decoded = false;
+    auto received = 0u;
+    while (!decoded && received < 2 * input_symbols)
+    {
+        ASSERT_TRUE(second.recode(symbol.data(), coefficients.data()));
+        decoder.feed_combination(symbol.data(), coefficients.data(), true);
+        ++received;
+        decoded = decoder.decode();
+    }
+    ASSERT_TRUE(decoded);
+    // recoding keeps the RLF overhead, a handful of extra symbols
+    EXPECT_LE(received, input_symbols + 20);
+
+    auto* payload = decoder.decoded_buffer();
+    std::vector<char> result(payload, payload + total_data_size);
+    delete[] payload;
+    ASSERT_THAT(result, Eq(data));
+}
+
+TEST(Recoder, EmptyAndZeroCombinations)
+{
+    using namespace Codes::Fountain;
+    auto symbol_length = 8u;
+    auto input_symbols = 70u;
+    Recoder recoder(input_symbols, symbol_length, 4);
+    std::vector<char> symbol(symbol_length, 1);
+    std::vector<uint64_t> coefficients(recoder.row_words(), 0);
+
+    EXPECT_FALSE(recoder.recode(symbol.data(), coefficients.data()));
+    EXPECT_FALSE(recoder.add_symbol(symbol.data(), coefficients.data()));
+
+    // a single buffered symbol is forwarded as it is
+    coefficients[1] = 0x20;
+    ASSERT_TRUE(recoder.add_symbol(symbol.data(), coefficients.data()));
+    for (auto idx = 0u; idx < 8; ++idx)
+    {
+        std::vector<char> out(symbol_length);
+        std::vector<uint64_t> out_coefficients(recoder.row_words());
+        ASSERT_TRUE(recoder.recode(out.data(), out_coefficients.data()));
+        EXPECT_THAT(out, Eq(symbol));
+        EXPECT_THAT(out_coefficients, Eq(coefficients));
+    }
+
+    for (auto idx = 0u; idx < 10; ++idx)
+        recoder.add_symbol(symbol.data(), coefficients.data());
+    EXPECT_EQ(recoder.size(), 4u);
+}
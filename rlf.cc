@@ -1,10 +1,14 @@
+#include "code_graph.h"
 #include "rlf.h"
+#include "xoshiro256.h"
 
 #include <gmock/gmock-matchers.h>
 #include <gmock/gmock-more-matchers.h>
 #include <gtest/gtest.h>
 #include <spdlog/spdlog.h>
 
+#include <thread>
+
 using namespace testing;
 
 TEST(Well512, BitDistribution)
@@ -132,3 +136,542 @@ TEST(RLF, EncodeOnTheFly)
             delete[] encoded_symbol;
     }
 }
+
+TEST(RLF, DecoderStats)
+{
+    spdlog::set_level(spdlog::level::debug);
+    auto symbol_length = 2u;
+    auto input_symbol_num = 100u;
+    auto total_data_size = input_symbol_num * symbol_length;
+    auto encode_number = input_symbol_num + 10;
+    auto seed = 13u;
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 3);
+
+    Codes::Fountain::RLF encoder;
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    Codes::Fountain::RLF decoder;
+    decoder.set_seed(seed);
+    decoder.set_input_data_size(total_data_size);
+    decoder.set_symbol_length(symbol_length);
+    decoder.stats().enable_timers(true);
+
+    std::vector<std::unique_ptr<char[]>> encoded_symbols;
+    for (auto enc_num = 0u; enc_num < encode_number; ++enc_num)
+    {
+        encoded_symbols.emplace_back(encoder.generate_symbol());
+        decoder.feed_symbol(encoded_symbols.back().get(), enc_num, true);
+    }
+    ASSERT_TRUE(decoder.decode());
+
+    const auto& stats = decoder.stats();
+    EXPECT_EQ(stats.symbols_received, encode_number);
+    EXPECT_EQ(stats.pivots, input_symbol_num);
+    EXPECT_EQ(stats.useless_symbols, encode_number - input_symbol_num);
+    EXPECT_GT(stats.row_operations, 0u);
+    EXPECT_EQ(stats.bytes_xored, stats.row_operations * symbol_length);
+    EXPECT_GT(stats.cycles(Codes::Fountain::Phase::Eliminate), 0u);
+
+    auto text = stats.to_text("rlf");
+    EXPECT_THAT(text, HasSubstr(fmt::format("rlf_pivots {}\n", input_symbol_num)));
+    EXPECT_THAT(text, HasSubstr("rlf_back_substitute_cycles "));
+}
+
+TEST(Well512, BulkBits)
+{
+    well_512 bit_generator;
+    well_512 bulk_generator;
+    bit_generator.set_seed(13u);
+    bulk_generator.set_seed(13u);
+
+    // odd sizes on purpose, so bulk calls start in the middle of a word
+    for (auto bits : {1u, 100u, 64u, 1000u, 3u, 129u})
+    {
+        std::vector<uint64_t> words((bits + 63) / 64);
+        bulk_generator.fill_bits(words.data(), bits);
+        for (auto idx = 0u; idx < bits; ++idx)
+            ASSERT_EQ(bit_generator.rand_bit(), (words[idx / 64] >> (idx % 64)) & 1) << bits << " " << idx;
+    }
+
+    for (auto bits : {7u, 500u, 64u})
+    {
+        for (auto idx = 0u; idx < bits; ++idx)
+            bit_generator.rand_bit();
+        bulk_generator.discard_bits(bits);
+        ASSERT_EQ(bit_generator.rand_bit(), bulk_generator.rand_bit());
+    }
+
+    std::vector<uint64_t> values(10);
+    bulk_generator.fill(values.data(), values.size());
+    bit_generator = bulk_generator;
+    std::vector<double> floats(10);
+    bulk_generator.fill_float(floats.data(), floats.size());
+    for (auto value : floats)
+        EXPECT_EQ(value, bit_generator.rand_float());
+}
+
+TEST(Xoshiro256, BulkMatchesScalar)
+{
+    xoshiro_256 scalar;
+    xoshiro_256 bulk;
+    scalar.set_seed(13u);
+    bulk.set_seed(13u);
+
+    scalar();
+    bulk();
+    std::vector<uint64_t> values(1001);
+    bulk.fill(values.data(), values.size());
+    for (auto value : values)
+        ASSERT_EQ(value, scalar());
+
+    std::vector<uint64_t> words(2);
+    scalar.rand_bit();
+    bulk.rand_bit();
+    bulk.fill_bits(words.data(), 100);
+    for (auto idx = 0u; idx < 100; ++idx)
+        ASSERT_EQ(scalar.rand_bit(), (words[idx / 64] >> (idx % 64)) & 1);
+
+    auto total_samples = 1'000'000u;
+    auto sum = 0.0;
+    for (auto idx = 0u; idx < total_samples; ++idx)
+        sum += bulk.rand_float();
+    EXPECT_THAT(sum / total_samples, DoubleNear(0.5, 0.001));
+}
+
+TEST(Prng, BulkMatchesScalar)
+{
+    using namespace Codes::Fountain;
+    for (auto type : {PrngType::Well512, PrngType::Xoshiro256})
+    {
+        Prng scalar;
+        Prng bulk;
+        scalar.set_type(type);
+        bulk.set_type(type);
+        scalar.set_seed(13u);
+        bulk.set_seed(13u);
+
+        std::vector<uint64_t> values(101);
+        bulk.fill(values.data(), values.size());
+        for (auto value : values)
+            ASSERT_EQ(value, scalar());
+
+        std::vector<double> floats(10);
+        bulk.fill_float(floats.data(), floats.size());
+        for (auto value : floats)
+            ASSERT_EQ(value, scalar.rand_float());
+
+        // aligned bulk bits first, then a partial word and an unaligned run
+        for (auto bits : {256u, 10u, 200u})
+        {
+            std::vector<uint64_t> words((bits + 63) / 64);
+            bulk.fill_bits(words.data(), bits);
+            for (auto idx = 0u; idx < bits; ++idx)
+                ASSERT_EQ(scalar.rand_bit(), (words[idx / 64] >> (idx % 64)) & 1) << bits << " " << idx;
+        }
+    }
+}
+
+TEST(RLF, EncodeXoshiro)
+{
+    spdlog::set_level(spdlog::level::debug);
+    auto symbol_length = 2u;
+    auto input_symbol_num = 300u;
+    auto total_data_size = input_symbol_num * symbol_length;
+    auto encode_number = input_symbol_num + 20;
+    auto seed = 13u;
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 5);
+
+    Codes::Fountain::RLF encoder;
+    encoder.set_generator(Codes::Fountain::PrngType::Xoshiro256);
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    Codes::Fountain::RLF decoder;
+    decoder.set_generator(Codes::Fountain::PrngType::Xoshiro256);
+    decoder.set_seed(seed);
+    decoder.set_input_data_size(total_data_size);
+    decoder.set_symbol_length(symbol_length);
+
+    // every other symbol is lost, so decoder has to catch up the generator
+    std::vector<std::unique_ptr<char[]>> encoded_symbols;
+    for (auto enc_num = 0u; enc_num < 2 * encode_number; ++enc_num)
+    {
+        encoded_symbols.emplace_back(encoder.generate_symbol());
+        if (enc_num % 2)
+            decoder.feed_symbol(encoded_symbols.back().get(), enc_num, true);
+    }
+    ASSERT_TRUE(decoder.decode());
+    std::unique_ptr<char[]> payload(decoder.decoded_buffer());
+    std::vector<char> decoded(payload.get(), payload.get() + total_data_size);
+    ASSERT_THAT(decoded, Eq(data));
+}
+
+TEST(RLF, SharedCodeGraph)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto symbol_length = 2u;
+    auto input_symbol_num = 150u;
+    auto total_data_size = input_symbol_num * symbol_length;
+    auto seed = 13u;
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 5);
+
+    auto graph = CodeGraphCache::instance().rlf(seed, input_symbol_num, 100);
+    EXPECT_EQ(graph, CodeGraphCache::instance().rlf(seed, input_symbol_num, 100));
+
+    RLF plain;
+    plain.set_seed(seed);
+    plain.set_input_data(data.data(), data.size());
+    plain.set_symbol_length(symbol_length);
+
+    RLF encoder;
+    encoder.set_code_graph(graph);
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    RLF decoder;
+    decoder.set_code_graph(graph);
+    decoder.set_seed(seed);
+    decoder.set_input_data_size(total_data_size);
+    decoder.set_symbol_length(symbol_length);
+
+    std::vector<std::unique_ptr<char[]>> encoded_symbols;
+    for (auto enc_num = 0u; enc_num < 2 * input_symbol_num + 40; ++enc_num)
+    {
+        std::unique_ptr<char[]> expected(plain.generate_symbol());
+        encoded_symbols.emplace_back(encoder.generate_symbol());
+        ASSERT_EQ(memcmp(expected.get(), encoded_symbols.back().get(), symbol_length), 0) << enc_num;
+        if (enc_num % 2)
+            decoder.feed_symbol(encoded_symbols.back().get(), enc_num, true);
+    }
+    ASSERT_TRUE(decoder.decode());
+    std::unique_ptr<char[]> payload(decoder.decoded_buffer());
+    ASSERT_EQ(memcmp(payload.get(), data.data(), total_data_size), 0);
+    CodeGraphCache::instance().clear();
+}
+
+TEST(RLF, RejectsMismatchedCodeGraph)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto input_symbols = 64u;
+    auto graph = CodeGraph::build_rlf(13u, input_symbols, 100);
+
+    RLF codec;
+    codec.set_seed(13u);
+    codec.set_input_data_size(input_symbols);
+    codec.set_symbol_length(1);
+    EXPECT_FALSE(codec.set_code_graph(CodeGraph::build_rlf(13u, input_symbols / 2, 100)));
+    EXPECT_TRUE(codec.set_code_graph(graph));
+
+    // attached before the generator is selected, a Well512 graph is skipped
+    RLF plain;
+    plain.set_generator(PrngType::Xoshiro256);
+    plain.set_seed(13u);
+    plain.set_input_data_size(input_symbols);
+    plain.set_symbol_length(1);
+    RLF other;
+    EXPECT_TRUE(other.set_code_graph(graph));
+    other.set_generator(PrngType::Xoshiro256);
+    other.set_seed(13u);
+    other.set_input_data_size(input_symbols);
+    other.set_symbol_length(1);
+    for (auto number = 0u; number < 100; ++number)
+    {
+        plain.load_symbol(number);
+        other.load_symbol(number);
+        ASSERT_THAT(other._current_hash_bits, Eq(plain._current_hash_bits)) << number;
+    }
+}
+
+TEST(CodeGraphCache, EvictsLeastRecentlyUsed)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto& cache = CodeGraphCache::instance();
+    auto capacity = cache.capacity();
+    cache.clear();
+    cache.set_capacity(2);
+
+    auto first = cache.rlf(1u, 16, 32);
+    auto second = cache.rlf(2u, 16, 32);
+    EXPECT_EQ(cache.rlf(1u, 16, 32), first);
+    cache.rlf(3u, 16, 32);
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.rlf(1u, 16, 32), first);
+    // evicted graph stays valid for its holders, a new request rebuilds it
+    EXPECT_EQ(second->symbols(), 32u);
+    EXPECT_NE(cache.rlf(2u, 16, 32), second);
+
+    // concurrent requests for one key share a single build
+    std::vector<std::shared_ptr<const CodeGraph>> graphs(8);
+    std::vector<std::thread> threads;
+    for (auto& graph : graphs)
+        threads.emplace_back([&graph, &cache] { graph = cache.rlf(4u, 256, 512); });
+    for (auto& thread : threads)
+        thread.join();
+    EXPECT_THAT(graphs, Each(Eq(graphs.front())));
+
+    cache.set_capacity(capacity);
+    cache.clear();
+}
+
+TEST(RLF, ReloadSameSymbol)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto input_symbols = 64u;
+    RLF plain;
+    plain.set_seed(13u);
+    plain.set_input_data_size(input_symbols);
+    plain.set_symbol_length(1);
+    RLF codec;
+    codec.set_systematic(true);
+    codec.set_seed(13u);
+    codec.set_input_data_size(input_symbols);
+    codec.set_symbol_length(1);
+
+    plain.load_symbol(20);
+    codec.load_symbol(input_symbols + 20);
+    // a rewind would regenerate from the changed seed
+    codec._seed = 14u;
+    codec.load_symbol(input_symbols + 20);
+    EXPECT_THAT(codec._current_hash_bits, Eq(plain._current_hash_bits));
+    codec._seed = 13u;
+
+    // systematic symbol in between overwrites the row, reload has to rewind
+    codec.load_symbol(3);
+    codec.load_symbol(input_symbols + 20);
+    EXPECT_THAT(codec._current_hash_bits, Eq(plain._current_hash_bits));
+    plain.load_symbol(21);
+    codec.load_symbol(input_symbols + 21);
+    EXPECT_THAT(codec._current_hash_bits, Eq(plain._current_hash_bits));
+}
+
+TEST(RLF, ResetReusesDecoder)
+{
+    spdlog::set_level(spdlog::level::debug);
+    Codes::Fountain::RLF decoder;
+    for (auto [symbol_length, input_symbol_num] : {std::pair{2u, 100u}, std::pair{2u, 100u}, std::pair{3u, 50u}})
+    {
+        auto total_data_size = input_symbol_num * symbol_length;
+        auto seed = 13u + input_symbol_num;
+        std::vector<char> data(total_data_size);
+        for (auto idx = 0u; idx < total_data_size; ++idx)
+            data[idx] = static_cast<char>(idx * 5 + seed);
+
+        Codes::Fountain::RLF encoder;
+        encoder.set_seed(seed);
+        encoder.set_input_data(data.data(), data.size());
+        encoder.set_symbol_length(symbol_length);
+
+        decoder.reset(seed, total_data_size, symbol_length);
+        std::vector<char> symbol(symbol_length);
+        for (auto enc_num = 0u; enc_num < input_symbol_num + 20; ++enc_num)
+        {
+            encoder.generate_symbol(enc_num, symbol.data());
+            decoder.feed_symbol(symbol.data(), enc_num, true);
+        }
+        ASSERT_TRUE(decoder.decode());
+        std::unique_ptr<char[]> payload(decoder.decoded_buffer());
+        ASSERT_EQ(memcmp(payload.get(), data.data(), total_data_size), 0);
+        EXPECT_EQ(decoder.stats().symbols_received, input_symbol_num + 20);
+    }
+}
+
+
+TEST(RLF, FeedSymbolsBatches)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto symbol_length = 8u;
+    auto input_symbols = 200u;
+    auto total_data_size = symbol_length * input_symbols;
+    auto seed = 13u;
+    auto batch_size = 32u;
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 5);
+
+    RLF encoder;
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    RLF decoder;
+    decoder.set_seed(seed);
+    decoder.set_input_data_size(total_data_size);
+    decoder.set_symbol_length(symbol_length);
+
+    std::vector<char> symbol(symbol_length);
+    std::vector<SymbolPacket> batch;
+    auto decoded = false;
+    for (auto first = 0u; !decoded && first < 4 * input_symbols; first += batch_size)
+    {
+        batch.clear();
+        for (auto number = first + batch_size; number-- > first;)
+        {
+            if (number % 5 == 1)
+                continue;
+            encoder.generate_symbol(number, symbol.data());
+            auto* copy = new char[symbol_length];
+            memcpy(copy, symbol.data(), symbol_length);
+            batch.push_back({copy, number});
+        }
+        decoded = decoder.feed_symbols(batch, true);
+        for (auto& packet : batch)
+            delete[] packet.data;
+    }
+    ASSERT_TRUE(decoded);
+    std::unique_ptr<char[]> payload(decoder.decoded_buffer());
+    ASSERT_EQ(memcmp(payload.get(), data.data(), total_data_size), 0);
+}
+TEST(RLF, SystematicLossyLink)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto symbol_length = 8u;
+    auto input_symbols = 300u;
+    auto total_data_size = symbol_length * input_symbols;
+    auto seed = 13u;
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 5 + 1);
+
+    RLF encoder;
+    encoder.set_systematic(true);
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    RLF decoder;
+    decoder.set_systematic(true);
+    decoder.set_seed(seed);
+    decoder.set_input_data_size(total_data_size);
+    decoder.set_symbol_length(symbol_length);
+
+    // every 50th symbol is lost, source symbols are sent first and a few
+    // repair symbols follow
+    std::vector<char> symbol(symbol_length);
+    auto missing = 0u;
+    for (auto number = 0u; number < input_symbols + 20; ++number)
+    {
+        encoder.generate_symbol(number, symbol.data());
+        if (number < input_symbols)
+        {
+            ASSERT_EQ(memcmp(symbol.data(), data.data() + number * symbol_length, symbol_length), 0);
+        }
+        if (number % 50 == 7)
+        {
+            missing += number < input_symbols;
+            continue;
+        }
+        decoder.feed_symbol(symbol.data(), number, true);
+    }
+    // nothing solved before decode()
+    EXPECT_EQ(decoder.decoded_buffer(), nullptr);
+    ASSERT_TRUE(decoder.decode());
+    // only the missing columns took part in elimination
+    EXPECT_EQ(decoder.stats().pivots, missing);
+    std::unique_ptr<char[]> payload(decoder.decoded_buffer());
+    ASSERT_EQ(memcmp(payload.get(), data.data(), total_data_size), 0);
+}
+
+TEST(RLF, CombinationPaddingIgnored)
+{
+    using namespace Codes::Fountain;
+    auto symbol_length = 8u;
+    auto input_symbols = 100u;
+    auto total_data_size = symbol_length * input_symbols;
+    auto seed = 13u;
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 3 + 7);
+
+    RLF encoder;
+    encoder.set_systematic(true);
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    RLF decoder;
+    decoder.set_systematic(true);
+    decoder.set_seed(seed);
+    decoder.set_input_data_size(total_data_size);
+    decoder.set_symbol_length(symbol_length);
+
+    // every 10th source is lost, repair rows come from a relay that leaves
+    // junk in the bits past the last input
+    std::vector<char> symbol(symbol_length);
+    std::vector<uint64_t> coefficients(encoder.row_words());
+    for (auto number = 0u; number < input_symbols + 30; ++number)
+    {
+        encoder.generate_symbol(number, symbol.data());
+        if (number < input_symbols)
+        {
+            if (number % 10 != 3)
+                decoder.feed_symbol(symbol.data(), number, true);
+            continue;
+        }
+        encoder.symbol_coefficients(number, coefficients.data());
+        coefficients.back() |= ~uint64_t(0) << (input_symbols % 64);
+        decoder.feed_combination(symbol.data(), coefficients.data(), true);
+    }
+    ASSERT_TRUE(decoder.decode());
+    std::unique_ptr<char[]> payload(decoder.decoded_buffer());
+    ASSERT_EQ(memcmp(payload.get(), data.data(), total_data_size), 0);
+}
+
+TEST(RLF, StreamingEncoderConstantMemory)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto symbol_length = 8u;
+    auto input_symbols = 64u;
+    auto total_data_size = symbol_length * input_symbols;
+    auto seed = 13u;
+    auto skipped = 20'000u;
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 3 + 7);
+
+    RLF encoder;
+    encoder.set_streaming(true);
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    // receiver joins a long running stream
+    std::vector<char> symbol(symbol_length);
+    for (auto idx = 0u; idx < skipped; ++idx)
+        ASSERT_EQ(encoder.next_symbol(symbol.data()), idx);
+    delete[] encoder.generate_symbol();
+    ++skipped;
+    EXPECT_TRUE(encoder._hash_bits.empty());
+
+    RLF decoder;
+    decoder.set_seed(seed);
+    decoder.set_input_data_size(total_data_size);
+    decoder.set_symbol_length(symbol_length);
+    auto decoded = false;
+    while (!decoded)
+    {
+        auto number = encoder.next_symbol(symbol.data());
+        ASSERT_LT(number, skipped + 2 * input_symbols);
+        decoder.feed_symbol(symbol.data(), number, true);
+        decoded = decoder.decode();
+    }
+    EXPECT_TRUE(encoder._hash_bits.empty());
+    std::unique_ptr<char[]> payload(decoder.decoded_buffer());
+    ASSERT_EQ(memcmp(payload.get(), data.data(), total_data_size), 0);
+}
@@ -0,0 +1,149 @@
+#include "lt.h"
+#include "rlf.h"
+#include "robust_soliton_distribution.h"
+#include "seed_search.h"
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+
+using namespace testing;
+
+namespace {
+bool rlf_decodes(uint32_t seed, size_t input_symbols, size_t received, Codes::Fountain::PrngType type)
+{
+    using namespace Codes::Fountain;
+    std::vector<char> data(input_symbols);
+    for (auto idx = 0u; idx < data.size(); ++idx)
+        data[idx] = static_cast<char>(idx * 7 + 3);
+    RLF encoder;
+    encoder.set_generator(type);
+    encoder.reset(seed, data.size(), 1);
+    encoder.set_input_data(data.data(), data.size());
+    RLF decoder;
+    decoder.set_generator(type);
+    decoder.reset(seed, data.size(), 1);
+    char symbol = 0;
+    for (auto number = 0u; number < received; ++number)
+    {
+        encoder.generate_symbol(number, &symbol);
+        decoder.feed_symbol(&symbol, number, true);
+    }
+    if (!decoder.decode())
+        return false;
+    std::unique_ptr<char[]> decoded(decoder.decoded_buffer());
+    return std::equal(data.begin(), data.end(), decoded.get());
+}
+
+bool lt_decodes(uint32_t seed, size_t input_symbols, size_t received)
+{
+    using namespace Codes::Fountain;
+    std::vector<char> data(input_symbols);
+    for (auto idx = 0u; idx < data.size(); ++idx)
+        data[idx] = static_cast<char>(idx * 7 + 3);
+    LT encoder(new RobustSolitonDistribution(0.05, 0.03));
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(1);
+    LT decoder(new RobustSolitonDistribution(0.05, 0.03));
+    decoder.set_seed(seed);
+    decoder.set_input_data_size(data.size());
+    decoder.set_symbol_length(1);
+    char symbol = 0;
+    for (auto number = 0u; number < received; ++number)
+    {
+        encoder.generate_symbol(number, &symbol);
+        decoder.feed_symbol(&symbol, number, Memory::MakeCopy, Decoding::Postpone);
+    }
+    if (!decoder.decode())
+        return false;
+    std::unique_ptr<char[]> decoded(decoder.decoded_buffer());
+    return std::equal(data.begin(), data.end(), decoded.get());
+}
+} // namespace
+
+TEST(SeedSearch, SimulationMatchesCodec)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto input_symbols = 48u;
+    SeedSearch::Options options;
+    options.trials = 0;
+    options.max_overhead = 4 * input_symbols;
+    for (auto seed = 1u; seed < 20; ++seed)
+    {
+        for (auto type : {PrngType::Well512, PrngType::Xoshiro256})
+        {
+            options.generator = type;
+            auto overhead = SeedSearch::score_rlf(seed, input_symbols, options).lossless_overhead;
+            EXPECT_TRUE(rlf_decodes(seed, input_symbols, input_symbols + overhead, type));
+            if (overhead != 0)
+            {
+                EXPECT_FALSE(rlf_decodes(seed, input_symbols, input_symbols + overhead - 1, type));
+            }
+        }
+
+        options.generator = PrngType::Well512;
+        auto overhead =
+            SeedSearch::score_lt([] { return new RobustSolitonDistribution(0.05, 0.03); }, seed, input_symbols, options)
+                .lossless_overhead;
+        if (overhead > options.max_overhead)
+            continue;
+        EXPECT_TRUE(lt_decodes(seed, input_symbols, input_symbols + overhead));
+        if (overhead != 0)
+        {
+            EXPECT_FALSE(lt_decodes(seed, input_symbols, input_symbols + overhead - 1));
+        }
+    }
+}
+
+TEST(SeedSearch, SearchRanksSeeds)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    SeedSearch::Options options;
+    options.trials = 4;
+    options.threads = 4;
+    options.generator = PrngType::Xoshiro256;
+    auto scores = SeedSearch::search_rlf(32, 0, 200, options);
+    // seed 0 is never scored
+    ASSERT_EQ(scores.size(), 199u);
+    EXPECT_TRUE(std::is_sorted(scores.begin(), scores.end(), SeedSearch::better));
+    EXPECT_THAT(scores, Each(Field(&SeedSearch::Score::seed, Ne(0u))));
+    // a random square matrix has full rank with probability ~0.29
+    EXPECT_EQ(scores.front().lossless_overhead, 0u);
+    EXPECT_TRUE(rlf_decodes(scores.front().seed, 32, 32, PrngType::Xoshiro256));
+}
+
+TEST(SeedSearch, RecommendedSeeds)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    ASSERT_FALSE(SeedSearch::recommendations().empty());
+    EXPECT_FALSE(SeedSearch::recommended_seed(CodeGraph::Kind::Rlf, 17).has_value());
+
+    auto rlf = SeedSearch::recommended_seed(CodeGraph::Kind::Rlf, 64, PrngType::Xoshiro256);
+    ASSERT_TRUE(rlf.has_value());
+    EXPECT_EQ(rlf->lossless_overhead, 0u);
+    EXPECT_TRUE(rlf_decodes(rlf->seed, 64, 64, PrngType::Xoshiro256));
+
+    auto key = RobustSolitonDistribution(0.05, 0.03).key();
+    auto lt = SeedSearch::recommended_seed(CodeGraph::Kind::Lt, 64, PrngType::Well512, key);
+    ASSERT_TRUE(lt.has_value());
+    EXPECT_TRUE(lt_decodes(lt->seed, 64, 64 + lt->lossless_overhead));
+
+    // table has to stay in sync with the simulation
+    SeedSearch::Options options;
+    options.trials = 0;
+    for (const auto& entry : SeedSearch::recommendations())
+    {
+        if (entry.input_symbols > 256)
+            continue;
+        options.generator = entry.generator;
+        auto score = entry.kind == CodeGraph::Kind::Rlf
+                         ? SeedSearch::score_rlf(entry.seed, entry.input_symbols, options)
+                         : SeedSearch::score_lt([] { return new RobustSolitonDistribution(0.05, 0.03); },
+                                                entry.seed, entry.input_symbols, options);
+        EXPECT_EQ(score.lossless_overhead, entry.lossless_overhead) << entry.input_symbols;
+    }
+}
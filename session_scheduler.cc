@@ -0,0 +1,145 @@
+#include "robust_soliton_distribution.h"
+#include "session_scheduler.h"
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+
+using namespace testing;
+
+namespace {
+std::vector<char> make_data(size_t size, size_t salt)
+{
+    std::vector<char> data(size);
+    for (auto idx = 0u; idx < size; ++idx)
+        data[idx] = static_cast<char>(idx * 7 + salt);
+    return data;
+}
+} // namespace
+
+TEST(SessionScheduler, MixedSessions)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto lt_sessions = 40u;
+    auto rlf_sessions = 2u;
+    auto symbol_length = 8u;
+    auto lt_symbols = 100u;
+    auto rlf_symbols = 300u;
+
+    SessionScheduler scheduler(4, 16);
+    std::vector<std::vector<char>> data;
+    std::vector<std::unique_ptr<char[]>> decoded(lt_sessions + rlf_sessions);
+    std::vector<std::future<bool>> futures;
+    std::vector<std::function<void(size_t, char*)>> encoders;
+    std::vector<std::shared_ptr<void>> encoder_storage;
+
+    auto on_complete = [&decoded](size_t id, DecodeSession& session) { decoded[id].reset(session.decoded_buffer()); };
+    for (auto id = 0u; id < lt_sessions + rlf_sessions; ++id)
+    {
+        auto is_rlf = id >= lt_sessions;
+        auto input_symbols = is_rlf ? rlf_symbols : lt_symbols;
+        data.push_back(make_data(input_symbols * symbol_length, id));
+        auto seed = 100u + id;
+        if (is_rlf)
+        {
+            auto encoder = std::make_shared<RLF>();
+            encoder->set_seed(seed);
+            encoder->set_input_data(data.back().data(), data.back().size());
+            encoder->set_symbol_length(symbol_length);
+            encoders.push_back([encoder](size_t number, char* out) { encoder->generate_symbol(number, out); });
+            encoder_storage.push_back(encoder);
+
+            auto decoder = std::make_unique<RLF>();
+            decoder->set_seed(seed);
+            decoder->set_input_data_size(data.back().size());
+            decoder->set_symbol_length(symbol_length);
+            futures.push_back(
+                scheduler.open(id, std::make_unique<CodecSession<RLF>>(std::move(decoder)), on_complete));
+        }
+        else
+        {
+            auto encoder = std::make_shared<LT>(new RobustSolitonDistribution(0.05, 0.03));
+            encoder->set_seed(seed);
+            encoder->set_input_data(data.back().data(), data.back().size());
+            encoder->set_symbol_length(symbol_length);
+            encoders.push_back([encoder](size_t number, char* out) { encoder->generate_symbol(number, out); });
+            encoder_storage.push_back(encoder);
+
+            auto decoder = std::make_unique<LT>(new RobustSolitonDistribution(0.05, 0.03));
+            decoder->set_seed(seed);
+            decoder->set_input_data_size(data.back().size());
+            decoder->set_symbol_length(symbol_length);
+            futures.push_back(scheduler.open(id, std::make_unique<CodecSession<LT>>(std::move(decoder)), on_complete));
+        }
+    }
+    EXPECT_EQ(scheduler.sessions(), lt_sessions + rlf_sessions);
+
+    // one I/O loop interleaving all sessions, keeps sending until everyone is done
+    std::vector<char> symbol(symbol_length);
+    for (auto number = 0u; number < 3 * rlf_symbols; ++number)
+        for (auto id = 0u; id < encoders.size(); ++id)
+        {
+            if (futures[id].wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                continue;
+            encoders[id](number, symbol.data());
+            scheduler.submit(id, symbol.data(), symbol_length, number);
+        }
+
+    for (auto id = 0u; id < futures.size(); ++id)
+    {
+        ASSERT_TRUE(futures[id].get()) << id;
+        ASSERT_TRUE(decoded[id]) << id;
+        EXPECT_EQ(memcmp(decoded[id].get(), data[id].data(), data[id].size()), 0) << id;
+    }
+}
+
+TEST(SessionScheduler, CloseBeforeComplete)
+{
+    using namespace Codes::Fountain;
+    SessionScheduler scheduler(2);
+    auto decoder = std::make_unique<RLF>();
+    decoder->set_seed(13);
+    decoder->set_input_data_size(1000);
+    decoder->set_symbol_length(10);
+    auto future = scheduler.open(7, std::make_unique<CodecSession<RLF>>(std::move(decoder)));
+    std::vector<char> symbol(10, 1);
+    EXPECT_TRUE(scheduler.submit(7, symbol.data(), symbol.size(), 0));
+    scheduler.close(7);
+    EXPECT_FALSE(future.get());
+    EXPECT_FALSE(scheduler.submit(7, symbol.data(), symbol.size(), 1));
+    EXPECT_EQ(scheduler.sessions(), 0u);
+}
+TEST(SessionScheduler, CloseDuringCompletion)
+{
+    using namespace Codes::Fountain;
+    auto data = make_data(40, 3);
+    RLF encoder;
+    encoder.set_seed(13);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(1);
+    auto decoder = std::make_unique<RLF>();
+    decoder->set_seed(13);
+    decoder->set_input_data_size(data.size());
+    decoder->set_symbol_length(1);
+
+    SessionScheduler scheduler(2);
+    std::promise<void> entered;
+    std::promise<void> release;
+    auto future =
+        scheduler.open(7, std::make_unique<CodecSession<RLF>>(std::move(decoder)), [&](size_t, DecodeSession&) {
+            entered.set_value();
+            release.get_future().wait();
+        });
+    char symbol = 0;
+    for (auto number = 0u; number < data.size() + 20; ++number)
+    {
+        encoder.generate_symbol(number, &symbol);
+        scheduler.submit(7, &symbol, 1, number);
+    }
+    entered.get_future().wait();
+    scheduler.close(7);
+    release.set_value();
+    EXPECT_TRUE(future.get());
+    EXPECT_EQ(scheduler.sessions(), 0u);
+}
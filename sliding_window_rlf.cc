@@ -0,0 +1,153 @@
+#include "sliding_window_rlf.h"
+
+#include <random>
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+
+using namespace testing;
+
+namespace {
+std::vector<char> make_source(size_t index, size_t symbol_length)
+{
+    std::vector<char> source(symbol_length);
+    for (auto idx = 0u; idx < symbol_length; ++idx)
+        source[idx] = static_cast<char>(index * 31 + idx);
+    return source;
+}
+} // namespace
+
+TEST(SlidingWindowRLF, LossyStreamInOrder)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto symbol_length = 16u;
+    auto window = 32u;
+    auto sources = 3000u;
+    auto seed = 13u;
+
+    SlidingWindowRLF encoder(window, symbol_length);
+    encoder.set_seed(seed);
+    SlidingWindowRLF decoder(window, symbol_length);
+    decoder.set_seed(seed);
+
+    std::vector<size_t> order;
+    auto mismatches = 0u;
+    auto pushed = 0u;
+    size_t max_latency = 0;
+    decoder.set_delivery([&](size_t index, const char* data) {
+        order.push_back(index);
+        max_latency = std::max<size_t>(max_latency, pushed - index);
+        if (data == nullptr || memcmp(data, make_source(index, symbol_length).data(), symbol_length) != 0)
+            ++mismatches;
+    });
+
+    // every source is sent as is, one repair symbol follows every second
+    // source and 15% of all packets are lost
+    std::mt19937 loss(7);
+    std::bernoulli_distribution lost(0.15);
+    std::vector<char> symbol(symbol_length);
+    for (auto index = 0u; index < sources; ++index)
+    {
+        auto source = make_source(index, symbol_length);
+        encoder.push_source(source.data());
+        pushed = index + 1;
+        if (!lost(loss))
+            decoder.feed_source(index, source.data());
+        if (index % 2 == 1)
+        {
+            auto header = encoder.generate_symbol(symbol.data());
+            if (!lost(loss))
+                decoder.feed_symbol(symbol.data(), header);
+        }
+    }
+    // tail of the stream is closed with extra repair symbols
+    while (decoder.delivered() < sources)
+    {
+        auto header = encoder.generate_symbol(symbol.data());
+        decoder.feed_symbol(symbol.data(), header);
+    }
+
+    EXPECT_EQ(decoder.lost(), 0u);
+    EXPECT_EQ(mismatches, 0u);
+    ASSERT_EQ(order.size(), sources);
+    for (auto idx = 0u; idx < sources; ++idx)
+        ASSERT_EQ(order[idx], idx);
+    // latency is bounded by the window, not by the stream length
+    EXPECT_LE(max_latency, 4 * window);
+}
+
+TEST(SlidingWindowRLF, LateSymbolTrimmedToWindow)
+{
+    using namespace Codes::Fountain;
+    auto symbol_length = 16u;
+    auto window = 4u;
+    SlidingWindowRLF encoder(window, symbol_length);
+    encoder.set_seed(5);
+    SlidingWindowRLF decoder(window, symbol_length);
+    decoder.set_seed(5);
+    auto mismatches = 0u;
+    decoder.set_delivery([&](size_t index, const char* data) {
+        if (data == nullptr || memcmp(data, make_source(index, symbol_length).data(), symbol_length) != 0)
+            ++mismatches;
+    });
+
+    // repair symbols for sources 0..3 arrive only after sources 0..2 are
+    // released, source 3 itself is lost
+    std::vector<std::pair<WindowSymbol, std::vector<char>>> late;
+    for (auto index = 0u; index < 7; ++index)
+    {
+        auto source = make_source(index, symbol_length);
+        encoder.push_source(source.data());
+        if (index != 3)
+            decoder.feed_source(index, source.data());
+        for (auto repair = 0u; index == 3 && repair < 4; ++repair)
+        {
+            std::vector<char> symbol(symbol_length);
+            auto header = encoder.generate_symbol(symbol.data());
+            late.emplace_back(header, std::move(symbol));
+        }
+    }
+    EXPECT_EQ(decoder.delivered(), 3u);
+    for (auto& [header, symbol] : late)
+        decoder.feed_symbol(symbol.data(), header);
+    EXPECT_EQ(decoder.delivered(), 7u);
+    EXPECT_EQ(decoder.lost(), 0u);
+    EXPECT_EQ(mismatches, 0u);
+}
+
+TEST(SlidingWindowRLF, BurstBeyondCapacity)
+{
+    using namespace Codes::Fountain;
+    auto symbol_length = 8u;
+    auto window = 8u;
+    SlidingWindowRLF encoder(window, symbol_length);
+    SlidingWindowRLF decoder(window, symbol_length, 64);
+
+    std::vector<const char*> delivered;
+    decoder.set_delivery([&](size_t, const char* data) { delivered.push_back(data); });
+
+    // sources 10..109 are never received, repair symbols only cover the
+    // last window, so the decoder has to give up on most of the burst
+    std::vector<char> symbol(symbol_length);
+    for (auto index = 0u; index < 200; ++index)
+    {
+        auto source = make_source(index, symbol_length);
+        encoder.push_source(source.data());
+        if (index < 10 || index >= 110)
+            decoder.feed_source(index, source.data());
+    }
+    for (auto idx = 0u; idx < 4 * window; ++idx)
+    {
+        auto header = encoder.generate_symbol(symbol.data());
+        decoder.feed_symbol(symbol.data(), header);
+    }
+
+    EXPECT_EQ(decoder.delivered(), 200u);
+    EXPECT_EQ(decoder.lost(), 100u);
+    ASSERT_EQ(delivered.size(), 200u);
+    EXPECT_NE(delivered[9], nullptr);
+    EXPECT_EQ(delivered[10], nullptr);
+    EXPECT_NE(delivered[150], nullptr);
+}
\ No newline at end of file
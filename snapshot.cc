@@ -0,0 +1,211 @@
+#include "ideal_soliton_distribution.h"
+#include "lt.h"
+#include "rlf.h"
+#include "robust_soliton_distribution.h"
+#include "snapshot.h"
+
+#include <filesystem>
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+
+using namespace testing;
+
+namespace {
+std::string snapshot_path(const std::string& name)
+{
+    auto path = std::filesystem::temp_directory_path() / ("rateless_codes_" + name + ".snapshot");
+    std::filesystem::remove(path);
+    return path.string();
+}
+
+std::string truncated_copy(const std::string& path, const std::string& name)
+{
+    auto truncated = snapshot_path(name);
+    std::filesystem::copy_file(path, truncated);
+    std::filesystem::resize_file(truncated, std::filesystem::file_size(path) / 2);
+    return truncated;
+}
+} // namespace
+
+TEST(Snapshot, LTResumeAfterRestart)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto symbol_length = 16u;
+    auto input_symbols = 500u;
+    auto total_data_size = symbol_length * input_symbols;
+    auto seed = 13u;
+    auto path = snapshot_path("lt");
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 7 + 3);
+
+    LT encoder(new RobustSolitonDistribution(0.05, 0.03));
+    encoder.set_generator(PrngType::Xoshiro256);
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    std::vector<char> symbol(symbol_length);
+    auto number = 0u;
+    {
+        LT decoder(new RobustSolitonDistribution(0.05, 0.03));
+        decoder.set_generator(PrngType::Xoshiro256);
+        decoder.set_seed(seed);
+        decoder.set_input_data_size(total_data_size);
+        decoder.set_symbol_length(symbol_length);
+        for (; number < input_symbols * 3 / 4; ++number)
+        {
+            encoder.generate_symbol(number, symbol.data());
+            ASSERT_FALSE(decoder.feed_symbol(symbol.data(), number));
+        }
+        ASSERT_TRUE(decoder.save_snapshot(path));
+        // a few more symbols arrive and are journaled before the restart
+        for (auto last = number + 20; number < last; ++number)
+        {
+            encoder.generate_symbol(number, symbol.data());
+            ASSERT_TRUE(Snapshot::append_symbol(path, number, symbol.data(), symbol_length));
+        }
+    }
+
+    LT mismatch(new IdealSolitonDistribution());
+    EXPECT_FALSE(mismatch.load_snapshot(path));
+
+    LT decoder(new RobustSolitonDistribution(0.05, 0.03));
+    ASSERT_TRUE(decoder.load_snapshot(path));
+    // counters carry over, journaled symbols are counted on top
+    EXPECT_EQ(decoder.stats().symbols_received, input_symbols * 3 / 4 + 20);
+    // a broken snapshot is rejected before the restored state is touched
+    auto truncated = truncated_copy(path, "lt_truncated");
+    EXPECT_FALSE(decoder.load_snapshot(truncated));
+    EXPECT_EQ(decoder.stats().symbols_received, input_symbols * 3 / 4 + 20);
+    std::filesystem::remove(truncated);
+    auto decoded = false;
+    for (; !decoded && number < 4 * input_symbols; ++number)
+    {
+        encoder.generate_symbol(number, symbol.data());
+        decoded = decoder.feed_symbol(symbol.data(), number);
+    }
+    ASSERT_TRUE(decoded);
+    std::unique_ptr<char[]> payload(decoder.decoded_buffer());
+    ASSERT_EQ(memcmp(payload.get(), data.data(), total_data_size), 0);
+    std::filesystem::remove(path);
+}
+
+TEST(Snapshot, SystematicRLFResumeAfterRestart)
+{
+    using namespace Codes::Fountain;
+    auto symbol_length = 8u;
+    auto input_symbols = 120u;
+    auto total_data_size = symbol_length * input_symbols;
+    auto seed = 21u;
+    auto path = snapshot_path("rlf");
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 5 + 1);
+
+    RLF encoder;
+    encoder.set_systematic(true);
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    // every 6th symbol is lost, restart happens after the first repair symbols
+    std::vector<char> symbol(symbol_length);
+    auto number = 0u;
+    auto fed = 0u;
+    {
+        RLF decoder;
+        decoder.set_systematic(true);
+        decoder.set_seed(seed);
+        decoder.set_input_data_size(total_data_size);
+        decoder.set_symbol_length(symbol_length);
+        for (; number < input_symbols + 5; ++number)
+        {
+            encoder.generate_symbol(number, symbol.data());
+            if (number % 6 == 2)
+                continue;
+            decoder.feed_symbol(symbol.data(), number, true);
+            ++fed;
+        }
+        ASSERT_FALSE(decoder.decode());
+        ASSERT_TRUE(decoder.save_snapshot(path));
+    }
+
+    RLF decoder;
+    ASSERT_TRUE(decoder.load_snapshot(path));
+    EXPECT_EQ(decoder.stats().symbols_received, fed);
+    auto truncated = truncated_copy(path, "rlf_truncated");
+    EXPECT_FALSE(decoder.load_snapshot(truncated));
+    EXPECT_EQ(decoder.stats().symbols_received, fed);
+    std::filesystem::remove(truncated);
+    auto decoded = false;
+    for (; !decoded && number < 2 * input_symbols; ++number)
+    {
+        encoder.generate_symbol(number, symbol.data());
+        decoder.feed_symbol(symbol.data(), number, true);
+        decoded = decoder.decode();
+    }
+    ASSERT_TRUE(decoded);
+    std::unique_ptr<char[]> payload(decoder.decoded_buffer());
+    ASSERT_EQ(memcmp(payload.get(), data.data(), total_data_size), 0);
+    std::filesystem::remove(path);
+}
+
+TEST(Snapshot, LTRestoreUnderMemoryBudget)
+{
+    using namespace Codes::Fountain;
+    auto symbol_length = 32u;
+    auto input_symbols = 1000u;
+    auto total_data_size = symbol_length * input_symbols;
+    auto seed = 17u;
+    auto budget = 50u * symbol_length;
+    auto path = snapshot_path("lt_budget");
+    auto scratch = snapshot_path("lt_budget_scratch");
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 13 + 9);
+
+    LT encoder(new RobustSolitonDistribution(0.05, 0.03));
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    std::vector<char> symbol(symbol_length);
+    auto number = 0u;
+    {
+        LT decoder(new RobustSolitonDistribution(0.05, 0.03));
+        decoder.set_seed(seed);
+        decoder.set_input_data_size(total_data_size);
+        decoder.set_symbol_length(symbol_length);
+        for (; number < input_symbols * 3 / 4; ++number)
+        {
+            encoder.generate_symbol(number, symbol.data());
+            ASSERT_FALSE(decoder.feed_symbol(symbol.data(), number));
+        }
+        ASSERT_TRUE(decoder.save_snapshot(path));
+    }
+
+    // restored droplets are held to the budget like fed ones
+    LT decoder(new RobustSolitonDistribution(0.05, 0.03));
+    ASSERT_TRUE(decoder.set_memory_budget(budget, scratch));
+    ASSERT_TRUE(decoder.load_snapshot(path));
+    EXPECT_GT(decoder.spilled_symbols(), 0u);
+    ASSERT_LE(decoder._resident_bytes, budget);
+    auto decoded = false;
+    for (; !decoded && number < 4 * input_symbols; ++number)
+    {
+        encoder.generate_symbol(number, symbol.data());
+        decoded = decoder.feed_symbol(symbol.data(), number);
+        ASSERT_LE(decoder._resident_bytes, budget);
+        ASSERT_LE(decoder._spare_buffers.size(), LT::budget_spare_buffers);
+    }
+    ASSERT_TRUE(decoded);
+    std::unique_ptr<char[]> payload(decoder.decoded_buffer());
+    ASSERT_EQ(memcmp(payload.get(), data.data(), total_data_size), 0);
+    decoder.set_memory_budget(0, scratch);
+    std::filesystem::remove(path);
+    std::filesystem::remove(scratch);
+}
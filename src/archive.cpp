@@ -0,0 +1,351 @@
+#include "archive.h"
+
+#include "async_file_io.h"
+#include "crc32c.h"
+#include "rlf.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Codes::Fountain::Archive {
+
+namespace {
+class File
+{
+public:
+    File() = default;
+    File(const std::string& path, int flags)
+        : _fd(::open(path.c_str(), flags, 0644))
+    {}
+    ~File()
+    {
+        if (_fd >= 0)
+            ::close(_fd);
+    }
+    File(File&& other) noexcept
+        : _fd(std::exchange(other._fd, -1))
+    {}
+    File& operator=(File&& other) noexcept
+    {
+        std::swap(_fd, other._fd);
+        return *this;
+    }
+
+    int fd() const
+    {
+        return _fd;
+    }
+    explicit operator bool() const
+    {
+        return _fd >= 0;
+    }
+    uint64_t size() const
+    {
+        struct stat info
+        {};
+        return fstat(_fd, &info) == 0 ? static_cast<uint64_t>(info.st_size) : 0;
+    }
+
+private:
+    int _fd = -1;
+};
+
+// Geometry shared by encoder and decoder, records of one block are kept
+// shard by shard so every shard is one contiguous request per block
+struct Layout
+{
+    explicit Layout(const Header& header)
+        : symbol_length(header.symbol_length)
+        , block_symbols(header.block_symbols)
+        , symbols(header.block_symbols + header.repair_symbols)
+        , shards(header.shards)
+        , slots((symbols + shards - 1) / shards)
+        , record(symbol_length + sizeof(uint32_t))
+        , block_bytes(block_symbols * symbol_length)
+        , blocks((header.file_size + block_bytes - 1) / block_bytes)
+        , seed(header.seed)
+    {}
+
+    // well_512 seeded with 0 has an all zero state and only gives zero rows
+    uint32_t block_seed(size_t block) const
+    {
+        auto value = static_cast<uint32_t>(seed + block);
+        return value != 0 ? value : 1;
+    }
+
+    size_t buffer_offset(size_t symbol) const
+    {
+        return ((symbol % shards) * slots + symbol / shards) * record;
+    }
+    uint64_t file_offset(size_t block) const
+    {
+        return header_size + block * slots * record;
+    }
+
+    size_t symbol_length;
+    size_t block_symbols;
+    size_t symbols;
+    size_t shards;
+    size_t slots;
+    size_t record;
+    size_t block_bytes;
+    size_t blocks;
+    uint32_t seed;
+};
+
+bool same_archive(const Header& lhs, const Header& rhs)
+{
+    return lhs.shards == rhs.shards && lhs.seed == rhs.seed && lhs.file_size == rhs.file_size &&
+           lhs.symbol_length == rhs.symbol_length && lhs.block_symbols == rhs.block_symbols &&
+           lhs.repair_symbols == rhs.repair_symbols;
+}
+
+bool parse_shard_index(const std::string& file_name, const std::string& name, size_t& shard)
+{
+    static const std::string suffix = ".shard";
+    auto prefix = name + ".";
+    if (file_name.size() <= prefix.size() + suffix.size() || !file_name.starts_with(prefix) ||
+        !file_name.ends_with(suffix))
+        return false;
+    auto digits = file_name.substr(prefix.size(), file_name.size() - prefix.size() - suffix.size());
+    if (!std::all_of(digits.begin(), digits.end(), [](char c) { return c >= '0' && c <= '9'; }))
+        return false;
+    shard = std::stoull(digits);
+    return true;
+}
+
+// Blocks are decoded into target as they are read. A shard whose read
+// fails is left out of that block, only a failed write ends the restore.
+bool restore(const Header& header, const std::vector<File>& shards, const std::vector<uint64_t>& records,
+             const File& target)
+{
+    Layout layout(header);
+    std::array<std::vector<char>, 2> in;
+    std::array<std::unique_ptr<char[]>, 2> out;
+    std::array<std::vector<bool>, 2> dropped;
+    for (auto& buffer : in)
+        buffer.resize(layout.shards * layout.slots * layout.record);
+    AsyncFileIo io;
+    // truncated shards still give the records they kept
+    auto available = [&](size_t shard, size_t block) {
+        auto first = block * layout.slots;
+        return records[shard] > first ? std::min<uint64_t>(records[shard] - first, layout.slots) : 0;
+    };
+    // request id and shard of the reads in flight
+    std::vector<std::pair<size_t, size_t>> reads;
+    auto read_block = [&](size_t block) {
+        dropped[block % 2].assign(layout.shards, false);
+        for (auto shard = 0u; shard < layout.shards; ++shard)
+            if (auto count = available(shard, block); count != 0)
+                reads.emplace_back(io.read(shards[shard].fd(),
+                                           in[block % 2].data() + shard * layout.slots * layout.record,
+                                           count * layout.record, layout.file_offset(block)),
+                                   shard);
+    };
+    // waits for the reads of block and the previous write
+    auto settle = [&](size_t block) {
+        io.wait();
+        for (auto id : io.failed())
+        {
+            auto read = std::find_if(reads.begin(), reads.end(), [id](const auto& entry) { return entry.first == id; });
+            if (read == reads.end())
+                return false;
+            dropped[block % 2][read->second] = true;
+        }
+        reads.clear();
+        return true;
+    };
+
+    if (layout.blocks != 0)
+        read_block(0);
+    if (!settle(0))
+        return false;
+
+    RLF decoder;
+    decoder.set_systematic(true);
+    for (auto block = 0u; block < layout.blocks; ++block)
+    {
+        if (block + 1 < layout.blocks)
+            read_block(block + 1);
+        io.submit();
+
+        decoder.reset(layout.block_seed(block), layout.block_bytes, layout.symbol_length);
+        for (auto symbol = 0u; symbol < layout.symbols; ++symbol)
+        {
+            auto shard = symbol % layout.shards;
+            if (dropped[block % 2][shard] || symbol / layout.shards >= available(shard, block))
+                continue;
+            auto* record = in[block % 2].data() + layout.buffer_offset(symbol);
+            uint32_t tag = 0;
+            memcpy(&tag, record + layout.symbol_length, sizeof(tag));
+            decoder.feed_tagged_symbol(record, symbol, tag);
+        }
+        auto decoded = decoder.decode();
+
+        if (!settle(block + 1) || !decoded)
+            return false;
+        auto offset = block * layout.block_bytes;
+        out[block % 2].reset(decoder.decoded_buffer());
+        io.write(target.fd(), out[block % 2].get(), std::min<uint64_t>(layout.block_bytes, header.file_size - offset),
+                 offset);
+        io.submit();
+    }
+    return io.wait();
+}
+} // namespace
+
+std::string shard_path(const std::string& directory, const std::string& name, size_t shard)
+{
+    return (std::filesystem::path(directory) / (name + "." + std::to_string(shard) + ".shard")).string();
+}
+
+bool encode(const std::string& input, const std::string& name, const std::vector<std::string>& directories,
+            const Options& options)
+{
+    if (directories.empty() || options.symbol_length == 0 || options.block_symbols == 0)
+        return false;
+    File source(input, O_RDONLY);
+    if (!source)
+        return false;
+
+    Header header;
+    header.shards = static_cast<uint32_t>(options.shards != 0 ? options.shards : directories.size());
+    header.seed = options.seed;
+    header.file_size = source.size();
+    header.symbol_length = options.symbol_length;
+    header.block_symbols = options.block_symbols;
+    header.repair_symbols = options.repair_symbols;
+    Layout layout(header);
+
+    // block b is read into in[b % 2] while b - 1 is coded, records of b - 1
+    // are written while b is coded. Buffers outlive io, its destructor
+    // waits for requests still in flight
+    std::array<std::vector<char>, 2> in;
+    std::array<std::vector<char>, 2> out;
+    for (auto idx = size_t{0}; idx < 2; ++idx)
+    {
+        in[idx].resize(layout.block_bytes);
+        out[idx].resize(layout.shards * layout.slots * layout.record);
+    }
+    std::vector<File> shards;
+    std::vector<Header> headers(layout.shards, header);
+    AsyncFileIo io;
+    for (auto shard = 0u; shard < layout.shards; ++shard)
+    {
+        shards.emplace_back(shard_path(directories[shard % directories.size()], name, shard),
+                            O_WRONLY | O_CREAT | O_TRUNC);
+        if (!shards.back())
+            return false;
+        headers[shard].shard = shard;
+        io.write(shards.back().fd(), reinterpret_cast<const char*>(&headers[shard]), header_size, 0);
+    }
+
+    auto read_block = [&](size_t block) {
+        auto& buffer = in[block % 2];
+        auto offset = block * layout.block_bytes;
+        auto len = std::min<uint64_t>(layout.block_bytes, header.file_size - offset);
+        // last block is zero padded up to full size
+        std::fill(buffer.begin() + static_cast<std::ptrdiff_t>(len), buffer.end(), 0);
+        io.read(source.fd(), buffer.data(), len, offset);
+    };
+
+    if (layout.blocks != 0)
+        read_block(0);
+    if (!io.wait())
+        return false;
+
+    RLF encoder;
+    encoder.set_systematic(true);
+    for (auto block = 0u; block < layout.blocks; ++block)
+    {
+        if (block + 1 < layout.blocks)
+            read_block(block + 1);
+        io.submit();
+
+        auto& records = out[block % 2];
+        encoder.reset(layout.block_seed(block), layout.block_bytes, layout.symbol_length);
+        encoder.set_input_data(in[block % 2].data(), layout.block_bytes);
+        for (auto symbol = 0u; symbol < layout.symbols; ++symbol)
+        {
+            auto* record = records.data() + layout.buffer_offset(symbol);
+            encoder.generate_symbol(symbol, record);
+            auto tag = symbol_tag(record, layout.symbol_length, symbol);
+            memcpy(record + layout.symbol_length, &tag, sizeof(tag));
+        }
+
+        // previous writes have to finish before their buffer is coded into
+        if (!io.wait())
+            return false;
+        for (auto shard = 0u; shard < layout.shards; ++shard)
+            io.write(shards[shard].fd(), records.data() + shard * layout.slots * layout.record,
+                     layout.slots * layout.record, layout.file_offset(block));
+        io.submit();
+    }
+    if (!io.wait())
+        return false;
+    for (const auto& shard : shards)
+        if (fsync(shard.fd()) != 0)
+            return false;
+    return true;
+}
+
+bool decode(const std::string& name, const std::vector<std::string>& directories, const std::string& output)
+{
+    // first intact header decides, shards from another archive under the same
+    // name are skipped
+    std::vector<File> shards;
+    std::vector<uint64_t> records;
+    Header header;
+    auto found = false;
+    for (const auto& directory : directories)
+    {
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(directory, error))
+        {
+            size_t shard = 0;
+            if (!entry.is_regular_file(error) || !parse_shard_index(entry.path().filename().string(), name, shard))
+                continue;
+            File file(entry.path().string(), O_RDONLY);
+            Header candidate;
+            if (!file || pread(file.fd(), &candidate, header_size, 0) != static_cast<ssize_t>(header_size) ||
+                candidate.magic != magic || candidate.version != version || candidate.shard != shard ||
+                candidate.shard >= candidate.shards || candidate.symbol_length == 0 || candidate.block_symbols == 0)
+                continue;
+            if (!found)
+            {
+                header = candidate;
+                shards.resize(header.shards);
+                records.resize(header.shards);
+                found = true;
+            }
+            if (!same_archive(header, candidate) || shards[shard])
+                continue;
+            records[shard] = (file.size() - header_size) / (header.symbol_length + sizeof(uint32_t));
+            shards[shard] = std::move(file);
+        }
+    }
+    if (!found)
+        return false;
+
+    // output appears only once complete, an existing file survives a
+    // failed restore
+    auto partial = output + ".partial";
+    File target(partial, O_WRONLY | O_CREAT | O_TRUNC);
+    std::error_code error;
+    if (!target || !restore(header, shards, records, target) || fsync(target.fd()) != 0)
+    {
+        std::filesystem::remove(partial, error);
+        return false;
+    }
+    std::filesystem::rename(partial, output, error);
+    return !error;
+}
+} // namespace Codes::Fountain::Archive
@@ -0,0 +1,278 @@
+#include "async_file_io.h"
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define RATELESS_CODES_IO_URING
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
+
+namespace Codes::Fountain {
+
+namespace {
+template <typename T>
+T* ring_field(void* map, uint32_t offset)
+{
+    return reinterpret_cast<T*>(static_cast<char*>(map) + offset);
+}
+
+unsigned load_acquire(const unsigned* value)
+{
+    return std::atomic_ref<unsigned>(*const_cast<unsigned*>(value)).load(std::memory_order_acquire);
+}
+
+void store_release(unsigned* value, unsigned update)
+{
+    std::atomic_ref<unsigned>(*value).store(update, std::memory_order_release);
+}
+} // namespace
+
+AsyncFileIo::AsyncFileIo(unsigned depth, bool use_uring)
+{
+    if (!use_uring || !setup_uring(depth))
+        _pool = std::make_unique<ThreadPool>(std::min(depth, 8u));
+}
+
+AsyncFileIo::~AsyncFileIo()
+{
+    wait();
+    _pool.reset();
+    close_uring();
+}
+
+bool AsyncFileIo::uses_uring() const
+{
+    return _ring >= 0;
+}
+
+size_t AsyncFileIo::read(int fd, char* buffer, size_t len, uint64_t offset)
+{
+    _requests.push_back({fd, {buffer, len}, offset, false});
+    return _requests.size() - 1;
+}
+
+size_t AsyncFileIo::write(int fd, const char* buffer, size_t len, uint64_t offset)
+{
+    _requests.push_back({fd, {const_cast<char*>(buffer), len}, offset, true});
+    return _requests.size() - 1;
+}
+
+void AsyncFileIo::submit()
+{
+    for (; _submitted < _requests.size(); ++_submitted)
+    {
+        if (uses_uring() && submit_uring(_submitted))
+            continue;
+        {
+            std::lock_guard lock(_mutex);
+            ++_running;
+        }
+        // caller keeps queueing while this runs, the task gets its own copy
+        _pool->post([this, id = _submitted, request = _requests[_submitted]] { run(id, request); });
+    }
+    if (uses_uring() && _pending_submit != 0)
+        enter(0, 0);
+}
+
+bool AsyncFileIo::wait()
+{
+    submit();
+    while (uses_uring() && _in_flight != 0)
+        reap_uring(1);
+    if (_pool)
+    {
+        std::unique_lock lock(_mutex);
+        _done.wait(lock, [this] { return _running == 0; });
+    }
+    _requests.clear();
+    _submitted = 0;
+    _failed = std::move(_failing);
+    _failing.clear();
+    std::sort(_failed.begin(), _failed.end());
+    return _failed.empty();
+}
+
+const std::vector<size_t>& AsyncFileIo::failed() const
+{
+    return _failed;
+}
+
+void AsyncFileIo::run(size_t id, const Request& request)
+{
+    auto offset = static_cast<off_t>(request.offset);
+    auto done = request.write ? pwrite(request.fd, request.io.iov_base, request.io.iov_len, offset)
+                              : pread(request.fd, request.io.iov_base, request.io.iov_len, offset);
+    std::lock_guard lock(_mutex);
+    if (done != static_cast<ssize_t>(request.io.iov_len))
+        _failing.push_back(id);
+    if (--_running == 0)
+        _done.notify_all();
+}
+
+#if defined(RATELESS_CODES_IO_URING)
+bool AsyncFileIo::setup_uring(unsigned depth)
+{
+    io_uring_params params{};
+    auto ring = static_cast<int>(syscall(__NR_io_uring_setup, depth, &params));
+    if (ring < 0)
+        return false;
+
+    _sq_map_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    _cq_map_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP)
+        _sq_map_size = _cq_map_size = std::max(_sq_map_size, _cq_map_size);
+    _sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+
+    auto map = [ring](size_t size, off_t offset) {
+        auto* ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring, offset);
+        return ptr == MAP_FAILED ? nullptr : ptr;
+    };
+    _sq_map = map(_sq_map_size, IORING_OFF_SQ_RING);
+    _cq_map = params.features & IORING_FEAT_SINGLE_MMAP ? _sq_map : map(_cq_map_size, IORING_OFF_CQ_RING);
+    _sqes = map(_sqes_size, IORING_OFF_SQES);
+    _ring = ring;
+    if (!_sq_map || !_cq_map || !_sqes)
+    {
+        close_uring();
+        return false;
+    }
+
+    _sq_tail = ring_field<unsigned>(_sq_map, params.sq_off.tail);
+    _sq_mask = ring_field<unsigned>(_sq_map, params.sq_off.ring_mask);
+    _sq_array = ring_field<unsigned>(_sq_map, params.sq_off.array);
+    _cq_head = ring_field<unsigned>(_cq_map, params.cq_off.head);
+    _cq_tail = ring_field<unsigned>(_cq_map, params.cq_off.tail);
+    _cq_mask = ring_field<unsigned>(_cq_map, params.cq_off.ring_mask);
+    _cqes = ring_field<io_uring_cqe>(_cq_map, params.cq_off.cqes);
+    _entries = params.sq_entries;
+    return true;
+}
+
+bool AsyncFileIo::submit_uring(size_t id)
+{
+    // completion ring is at least as large as the submission ring, keeping
+    // in flight requests under sq_entries never overflows it
+    while (_in_flight == _entries)
+    {
+        if (_pending_submit != 0 && !enter(0, 0))
+            return false;
+        reap_uring(1);
+        if (!uses_uring())
+            return false;
+    }
+
+    const auto& request = _requests[id];
+    auto tail = *_sq_tail;
+    auto index = tail & *_sq_mask;
+    auto* sqe = static_cast<io_uring_sqe*>(_sqes) + index;
+    *sqe = io_uring_sqe{};
+    // vectored variants only need 5.1 kernels
+    sqe->opcode = request.write ? IORING_OP_WRITEV : IORING_OP_READV;
+    sqe->fd = request.fd;
+    sqe->addr = reinterpret_cast<uint64_t>(&request.io);
+    sqe->len = 1;
+    sqe->off = request.offset;
+    sqe->user_data = id;
+    _sq_array[index] = index;
+    store_release(_sq_tail, tail + 1);
+    ++_in_flight;
+    ++_pending_submit;
+    return true;
+}
+
+void AsyncFileIo::reap_uring(unsigned min_complete)
+{
+    auto head = *_cq_head;
+    if (head == load_acquire(_cq_tail) && !enter(min_complete, IORING_ENTER_GETEVENTS))
+        return;
+    for (; head != load_acquire(_cq_tail); ++head)
+    {
+        const auto& cqe = static_cast<io_uring_cqe*>(_cqes)[head & *_cq_mask];
+        auto& request = _requests[cqe.user_data];
+        if (cqe.res < 0 || static_cast<size_t>(cqe.res) != request.io.iov_len)
+            _failing.push_back(cqe.user_data);
+        request.reaped = true;
+        --_in_flight;
+    }
+    store_release(_cq_head, head);
+}
+
+// Submits whatever is pending and waits for min_complete completions. An
+// interrupted or busy call is retried, entries the kernel did not take yet
+// stay pending. Any other error drops the ring, false is returned then.
+bool AsyncFileIo::enter(unsigned min_complete, unsigned flags)
+{
+    while (true)
+    {
+        auto submitted = syscall(__NR_io_uring_enter, _ring, _pending_submit, min_complete, flags, nullptr, 0);
+        if (submitted >= 0)
+        {
+            _pending_submit -= std::min(_pending_submit, static_cast<size_t>(submitted));
+            if (_pending_submit == 0 || submitted == 0)
+                return true;
+        }
+        else if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+        {
+            drop_uring();
+            return false;
+        }
+    }
+}
+
+// Ring can not be trusted anymore, requests queued on it are failed and
+// the rest of them runs on the thread pool
+void AsyncFileIo::drop_uring()
+{
+    for (size_t id = 0; id < _submitted; ++id)
+        if (!_requests[id].reaped)
+            _failing.push_back(id);
+    _in_flight = 0;
+    _pending_submit = 0;
+    close_uring();
+    _pool = std::make_unique<ThreadPool>(std::min(_entries, 8u));
+}
+#else
+bool AsyncFileIo::setup_uring(unsigned)
+{
+    return false;
+}
+
+bool AsyncFileIo::submit_uring(size_t)
+{
+    return false;
+}
+
+void AsyncFileIo::reap_uring(unsigned)
+{}
+
+bool AsyncFileIo::enter(unsigned, unsigned)
+{
+    return false;
+}
+
+void AsyncFileIo::drop_uring()
+{}
+#endif
+
+void AsyncFileIo::close_uring()
+{
+    if (_sqes)
+        munmap(_sqes, _sqes_size);
+    if (_cq_map && _cq_map != _sq_map)
+        munmap(_cq_map, _cq_map_size);
+    if (_sq_map)
+        munmap(_sq_map, _sq_map_size);
+    _sq_map = _cq_map = _sqes = nullptr;
+    if (_ring >= 0)
+        close(_ring);
+    _ring = -1;
+}
+} // namespace Codes::Fountain
@@ -0,0 +1,64 @@
+#include "batch_encoder.h"
+
+#include "code_graph.h"
+
+#include <bit>
+#include <cstring>
+
+namespace Codes::Fountain {
+
+BatchEncoder::BatchEncoder(std::shared_ptr<const CodeGraph> graph, size_t messages, size_t symbol_length)
+    : _graph(std::move(graph))
+    , _messages(messages)
+    , _symbol_length(symbol_length)
+    , _block_size(messages * symbol_length)
+    , _xor(select_xor_kernel(_block_size))
+{}
+
+void BatchEncoder::interleave(std::span<const char* const> messages, size_t input_symbols, size_t symbol_length,
+                              char* out)
+{
+    for (size_t symbol = 0; symbol < input_symbols; ++symbol)
+        for (const auto* message : messages)
+        {
+            memcpy(out, message + symbol * symbol_length, symbol_length);
+            out += symbol_length;
+        }
+}
+
+void BatchEncoder::set_input_data(const char* ptr)
+{
+    _input_data = ptr;
+}
+
+size_t BatchEncoder::messages() const
+{
+    return _messages;
+}
+
+size_t BatchEncoder::block_size() const
+{
+    return _block_size;
+}
+
+bool BatchEncoder::generate_symbol(size_t number, char* out)
+{
+    if (number >= _graph->symbols())
+        return false;
+    memset(out, 0, _block_size);
+    if (_graph->kind() == CodeGraph::Kind::Lt)
+    {
+        for (auto neighbor : _graph->neighbors(number))
+            _xor(out, _input_data + neighbor * _block_size, _block_size);
+        return true;
+    }
+    const auto* row = _graph->row(number);
+    for (size_t word = 0; word < _graph->row_words(); ++word)
+        for (auto bits = row[word]; bits != 0; bits &= bits - 1)
+        {
+            auto column = word * 64 + static_cast<size_t>(std::countr_zero(bits));
+            _xor(out, _input_data + column * _block_size, _block_size);
+        }
+    return true;
+}
+} // namespace Codes::Fountain
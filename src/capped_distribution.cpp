@@ -0,0 +1,91 @@
+#include "capped_distribution.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace Codes::Fountain {
+
+CappedDistribution::CappedDistribution(DegreeDistribution* distribution, size_t max_degree)
+    : _distribution(distribution)
+    , _max_degree(std::max<size_t>(max_degree, 1))
+{}
+
+size_t CappedDistribution::max_degree() const
+{
+    return _max_degree;
+}
+
+void CappedDistribution::set_seed(uint32_t seed)
+{
+    _degree_dist.set_seed(seed);
+}
+
+void CappedDistribution::set_input_size(size_t input_symbols)
+{
+    // degrees above the cap keep probability 0, search stops at the cap
+    _cumulative_probabilities =
+        cumulative_probabilities(expected_distribution(input_symbols), std::min(_max_degree, input_symbols));
+}
+
+size_t CappedDistribution::symbol_degree()
+{
+    return sample_degree(_cumulative_probabilities, _degree_dist.rand_float());
+}
+
+std::vector<double> CappedDistribution::expected_distribution(size_t input_symbols)
+{
+    auto expected = _distribution->expected_distribution(input_symbols);
+    for (auto idx = _max_degree; idx < expected.size(); ++idx)
+        expected[idx] = 0.0;
+    auto distribution_sum = std::accumulate(expected.cbegin(), expected.cend(), 0.0);
+    if (distribution_sum == 0.0)
+        return expected;
+    for (auto& value : expected)
+        value /= distribution_sum;
+    return expected;
+}
+
+std::string CappedDistribution::key() const
+{
+    // a cap does not make the wrapped parameters known
+    if (!_distribution->cacheable())
+        return DegreeDistribution::key();
+    return "capped:" + std::to_string(_max_degree) + ":" + _distribution->key();
+}
+
+std::vector<CapImpact> cap_impact(const SeedSearch::DistributionFactory& distribution, size_t input_symbols,
+                                  const std::vector<size_t>& caps, size_t samples, const SeedSearch::Options& options)
+{
+    auto search = options;
+    search.trials = 0;
+    auto limit = options.max_overhead != 0 ? options.max_overhead : input_symbols;
+
+    std::vector<CapImpact> impact;
+    for (auto cap : caps)
+    {
+        SeedSearch::DistributionFactory factory = [&, cap]() -> DegreeDistribution* {
+            if (cap == 0)
+                return distribution();
+            return new CappedDistribution(distribution(), cap);
+        };
+
+        CapImpact entry;
+        entry.max_degree = cap;
+        auto expected = std::unique_ptr<DegreeDistribution>(factory())->expected_distribution(input_symbols);
+        for (auto idx = 0u; idx < expected.size(); ++idx)
+            entry.mean_degree += (idx + 1) * expected[idx];
+
+        auto scores = SeedSearch::search_lt(factory, input_symbols, 1, samples, search);
+        size_t total = 0;
+        for (const auto& score : scores)
+        {
+            total += score.lossless_overhead;
+            entry.worst_overhead = std::max(entry.worst_overhead, score.lossless_overhead);
+            entry.failures += score.lossless_overhead > limit;
+        }
+        entry.mean_overhead = scores.empty() ? 0.0 : static_cast<double>(total) / static_cast<double>(scores.size());
+        impact.push_back(entry);
+    }
+    return impact;
+}
+} // namespace Codes::Fountain
@@ -0,0 +1,166 @@
+#include "code_graph.h"
+
+#include "lt.h"
+#include "rlf.h"
+
+#include <algorithm>
+
+namespace Codes::Fountain {
+
+std::shared_ptr<const CodeGraph> CodeGraph::build_lt(DegreeDistribution* distribution, uint32_t seed,
+                                                     size_t input_symbols, size_t symbols, PrngType type)
+{
+    auto graph = std::make_shared<CodeGraph>();
+    graph->_distribution = distribution->key();
+    // run the codec itself, so the graph can not drift from generated symbols
+    LT builder(distribution);
+    builder.set_generator(type);
+    builder.set_seed(seed);
+    builder.set_input_data_size(input_symbols);
+    builder.set_symbol_length(1);
+
+    graph->_kind = Kind::Lt;
+    graph->_seed = seed;
+    graph->_generator = type;
+    graph->_symbols = symbols;
+    graph->_input_symbols = input_symbols;
+    graph->_offsets.reserve(symbols + 1);
+    graph->_offsets.push_back(0);
+    for (size_t number = 0; number < symbols; ++number)
+    {
+        builder.load_symbol(number);
+        graph->_neighbors.insert(graph->_neighbors.end(), builder._current_hash_bits.cbegin(),
+                                 builder._current_hash_bits.cend());
+        graph->_offsets.push_back(graph->_neighbors.size());
+    }
+    graph->_neighbors.shrink_to_fit();
+    return graph;
+}
+
+std::shared_ptr<const CodeGraph> CodeGraph::build_rlf(uint32_t seed, size_t input_symbols, size_t symbols,
+                                                      PrngType type)
+{
+    RLF builder;
+    builder.set_generator(type);
+    builder.set_seed(seed);
+    builder.set_input_data_size(input_symbols);
+    builder.set_symbol_length(1);
+
+    auto graph = std::make_shared<CodeGraph>();
+    graph->_kind = Kind::Rlf;
+    graph->_seed = seed;
+    graph->_generator = type;
+    graph->_symbols = symbols;
+    graph->_input_symbols = input_symbols;
+    graph->_row_words = builder._row_words;
+    graph->_rows.reserve(symbols * graph->_row_words);
+    for (size_t number = 0; number < symbols; ++number)
+    {
+        builder.load_symbol(number);
+        graph->_rows.insert(graph->_rows.end(), builder._current_hash_bits.cbegin(),
+                            builder._current_hash_bits.cend());
+    }
+    return graph;
+}
+
+CodeGraph::Kind CodeGraph::kind() const
+{
+    return _kind;
+}
+
+uint32_t CodeGraph::seed() const
+{
+    return _seed;
+}
+
+PrngType CodeGraph::generator() const
+{
+    return _generator;
+}
+
+const std::string& CodeGraph::distribution() const
+{
+    return _distribution;
+}
+
+size_t CodeGraph::input_symbols() const
+{
+    return _input_symbols;
+}
+
+size_t CodeGraph::row_words() const
+{
+    return _row_words;
+}
+
+CodeGraphCache& CodeGraphCache::instance()
+{
+    static CodeGraphCache cache;
+    return cache;
+}
+
+std::shared_ptr<const CodeGraph> CodeGraphCache::lt(DegreeDistribution* distribution, uint32_t seed,
+                                                    size_t input_symbols, size_t symbols, PrngType type)
+{
+    std::unique_ptr<DegreeDistribution> owned(distribution);
+    if (!owned->cacheable())
+        return CodeGraph::build_lt(owned.release(), seed, input_symbols, symbols, type);
+    auto slot = entry(Key{CodeGraph::Kind::Lt, seed, input_symbols, symbols, owned->key(), type});
+    std::call_once(slot->built,
+                   [&] { slot->graph = CodeGraph::build_lt(owned.release(), seed, input_symbols, symbols, type); });
+    return slot->graph;
+}
+
+std::shared_ptr<const CodeGraph> CodeGraphCache::rlf(uint32_t seed, size_t input_symbols, size_t symbols,
+                                                     PrngType type)
+{
+    auto slot = entry(Key{CodeGraph::Kind::Rlf, seed, input_symbols, symbols, std::string(), type});
+    std::call_once(slot->built, [&] { slot->graph = CodeGraph::build_rlf(seed, input_symbols, symbols, type); });
+    return slot->graph;
+}
+
+std::shared_ptr<CodeGraphCache::Entry> CodeGraphCache::entry(const Key& key)
+{
+    std::lock_guard lock(_mutex);
+    auto& slot = _graphs[key];
+    if (!slot)
+        slot = std::make_shared<Entry>();
+    slot->last_used = ++_requests;
+    auto found = slot;
+    evict();
+    return found;
+}
+
+void CodeGraphCache::evict()
+{
+    while (_graphs.size() > _capacity)
+        _graphs.erase(std::min_element(_graphs.begin(), _graphs.end(), [](const auto& lhs, const auto& rhs) {
+            return lhs.second->last_used < rhs.second->last_used;
+        }));
+}
+
+size_t CodeGraphCache::size() const
+{
+    std::lock_guard lock(_mutex);
+    return _graphs.size();
+}
+
+size_t CodeGraphCache::capacity() const
+{
+    std::lock_guard lock(_mutex);
+    return _capacity;
+}
+
+void CodeGraphCache::set_capacity(size_t capacity)
+{
+    std::lock_guard lock(_mutex);
+    _capacity = capacity;
+    evict();
+}
+
+void CodeGraphCache::clear()
+{
+    std::lock_guard lock(_mutex);
+    _graphs.clear();
+}
+} // namespace Codes::Fountain
\ No newline at end of file
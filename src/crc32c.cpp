@@ -0,0 +1,99 @@
+#include "crc32c.h"
+
+#include <array>
+#include <cstring>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define RATELESS_CODES_CRC32C_SSE42
+#include <nmmintrin.h>
+#endif
+
+namespace Codes::Fountain {
+
+namespace {
+constexpr uint32_t polynomial = 0x82F63B78;
+
+constexpr std::array<uint32_t, 256> make_table()
+{
+    std::array<uint32_t, 256> table{};
+    for (uint32_t idx = 0; idx < 256; ++idx)
+    {
+        auto crc = idx;
+        for (auto bit = 0; bit < 8; ++bit)
+            crc = (crc >> 1) ^ (crc & 1 ? polynomial : 0);
+        table[idx] = crc;
+    }
+    return table;
+}
+
+constexpr auto table = make_table();
+
+uint32_t crc32c_table(const char* data, size_t len, uint32_t crc)
+{
+    for (size_t idx = 0; idx < len; ++idx)
+        crc = (crc >> 8) ^ table[(crc ^ static_cast<uint8_t>(data[idx])) & 0xFF];
+    return crc;
+}
+
+#if defined(RATELESS_CODES_CRC32C_SSE42)
+__attribute__((target("sse4.2"))) uint32_t crc32c_sse42(const char* data, size_t len, uint32_t crc)
+{
+    size_t idx = 0;
+#if defined(__x86_64__)
+    uint64_t wide = crc;
+    for (; idx + sizeof(uint64_t) <= len; idx += sizeof(uint64_t))
+    {
+        uint64_t value;
+        memcpy(&value, data + idx, sizeof(value));
+        wide = _mm_crc32_u64(wide, value);
+    }
+    crc = static_cast<uint32_t>(wide);
+#endif
+    for (; idx < len; ++idx)
+        crc = _mm_crc32_u8(crc, static_cast<uint8_t>(data[idx]));
+    return crc;
+}
+#endif
+
+using CrcKernel = uint32_t (*)(const char* data, size_t len, uint32_t crc);
+
+CrcKernel select_crc_kernel()
+{
+#if defined(RATELESS_CODES_CRC32C_SSE42)
+    if (__builtin_cpu_supports("sse4.2"))
+        return crc32c_sse42;
+#endif
+    return crc32c_table;
+}
+
+CrcKernel crc_kernel()
+{
+    static const auto kernel = select_crc_kernel();
+    return kernel;
+}
+} // namespace
+
+uint32_t crc32c(const char* data, size_t len, uint32_t crc)
+{
+    return ~crc_kernel()(data, len, ~crc);
+}
+
+bool crc32c_hardware()
+{
+    return crc_kernel() != crc32c_table;
+}
+
+uint32_t symbol_tag(const char* data, size_t symbol_length, size_t number)
+{
+    uint64_t wide = number;
+    char prefix[sizeof(wide)];
+    memcpy(prefix, &wide, sizeof(wide));
+    return crc32c(data, symbol_length, crc32c(prefix, sizeof(prefix)));
+}
+
+void symbol_tags(const char* symbols, size_t count, size_t symbol_length, size_t first, uint32_t* tags)
+{
+    for (size_t idx = 0; idx < count; ++idx)
+        tags[idx] = symbol_tag(symbols + idx * symbol_length, symbol_length, first + idx);
+}
+} // namespace Codes::Fountain
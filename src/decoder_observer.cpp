@@ -0,0 +1,66 @@
+#include "decoder_observer.h"
+
+#include <algorithm>
+#include <bit>
+
+#include <spdlog/spdlog.h>
+
+namespace Codes::Fountain {
+
+RingBufferObserver::RingBufferObserver(size_t capacity)
+{
+    resize(capacity);
+}
+
+void RingBufferObserver::resize(size_t capacity)
+{
+    capacity = std::bit_ceil(std::max<size_t>(capacity, 1));
+    _events.assign(capacity, DecoderEvent{});
+    _mask = capacity - 1;
+    _head = 0;
+}
+
+void RingBufferObserver::clear()
+{
+    _head = 0;
+}
+
+size_t RingBufferObserver::size() const
+{
+    return std::min<uint64_t>(_head, _events.size());
+}
+
+uint64_t RingBufferObserver::total() const
+{
+    return _head;
+}
+
+std::vector<DecoderEvent> RingBufferObserver::events() const
+{
+    std::vector<DecoderEvent> ordered;
+    ordered.reserve(size());
+    for (auto idx = _head - size(); idx < _head; ++idx)
+        ordered.push_back(_events[idx & _mask]);
+    return ordered;
+}
+
+void TraceObserver::symbol_fed(size_t number, size_t degree)
+{
+    spdlog::trace("Received symbol {}, degree after reduction {}", number, degree);
+}
+
+void TraceObserver::symbol_released(size_t encoded, size_t input)
+{
+    spdlog::trace("Releasing encoded {}, connected to {}", encoded, input);
+}
+
+void TraceObserver::input_decoded(size_t input, size_t unknown)
+{
+    spdlog::trace("Decoded data {}, {} still unknown", input, unknown);
+}
+
+void TraceObserver::ripple_empty(size_t unknown)
+{
+    spdlog::trace("Ripple empty, {} still unknown", unknown);
+}
+} // namespace Codes::Fountain
\ No newline at end of file
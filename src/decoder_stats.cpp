@@ -0,0 +1,65 @@
+#include "decoder_stats.h"
+
+#include <chrono>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include <spdlog/spdlog.h>
+
+namespace Codes::Fountain {
+
+void DecoderStats::enable_timers(bool enable)
+{
+    timers_enabled = enable;
+}
+
+void DecoderStats::reset()
+{
+    auto timers = timers_enabled;
+    *this = DecoderStats{};
+    timers_enabled = timers;
+}
+
+uint64_t DecoderStats::cycles(Phase phase) const
+{
+    return phase_cycles[static_cast<size_t>(phase)];
+}
+
+std::string DecoderStats::to_text(std::string_view prefix) const
+{
+    std::string text;
+    auto append = [&text, prefix](std::string_view name, uint64_t value) {
+        text += fmt::format("{}_{} {}\n", prefix, name, value);
+    };
+    append("symbols_received", symbols_received);
+    append("redundant_symbols", redundant_symbols);
+    append("useless_symbols", useless_symbols);
+    append("corrupted_symbols", corrupted_symbols);
+    append("bytes_xored", bytes_xored);
+    append("ripple_high_water", ripple_high_water);
+    append("peeling_steps", peeling_steps);
+    append("pivots", pivots);
+    append("row_operations", row_operations);
+    if (timers_enabled)
+    {
+        append("feed_cycles", cycles(Phase::Feed));
+        append("peel_cycles", cycles(Phase::Peel));
+        append("eliminate_cycles", cycles(Phase::Eliminate));
+        append("back_substitute_cycles", cycles(Phase::BackSubstitute));
+    }
+    return text;
+}
+
+uint64_t DecoderStats::cycle_counter()
+{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+} // namespace Codes::Fountain
\ No newline at end of file
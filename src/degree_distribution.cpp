@@ -1 +1,35 @@
+#include "degree_distribution.h"
 
+#include <algorithm>
+#include <numeric>
+#include <typeinfo>
+
+namespace Codes::Fountain {
+
+std::string DegreeDistribution::key() const
+{
+    return std::string("type:") + typeid(*this).name();
+}
+
+bool DegreeDistribution::cacheable() const
+{
+    return key() != DegreeDistribution::key();
+}
+
+std::vector<double> DegreeDistribution::cumulative_probabilities(const std::vector<double>& probabilities,
+                                                                 size_t degrees)
+{
+    std::vector<double> cumulative(degrees);
+    std::partial_sum(probabilities.cbegin(), probabilities.cbegin() + static_cast<std::ptrdiff_t>(degrees),
+                     cumulative.begin());
+    return cumulative;
+}
+
+size_t DegreeDistribution::sample_degree(const std::vector<double>& cumulative_probabilities, double value)
+{
+    auto it = std::lower_bound(cumulative_probabilities.cbegin(), cumulative_probabilities.cend(), value);
+    if (it == cumulative_probabilities.cend())
+        return cumulative_probabilities.size();
+    return static_cast<size_t>(std::distance(cumulative_probabilities.cbegin(), it)) + 1;
+}
+} // namespace Codes::Fountain
@@ -0,0 +1,109 @@
+#include "degree_optimizer.h"
+
+#include "ideal_soliton_distribution.h"
+#include "tabulated_distribution.h"
+#include "xoshiro256.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace Codes::Fountain::DegreeOptimizer {
+
+namespace {
+std::vector<size_t> support_degrees(size_t input_symbols, std::vector<size_t> support)
+{
+    if (support.empty())
+    {
+        for (size_t degree = 1; degree <= std::min<size_t>(8, input_symbols); ++degree)
+            support.push_back(degree);
+        for (size_t degree = 16; degree <= input_symbols; degree *= 2)
+            support.push_back(degree);
+    }
+    support.push_back(1);
+    std::erase_if(support, [&](size_t degree) { return degree == 0 || degree > input_symbols; });
+    std::sort(support.begin(), support.end());
+    support.erase(std::unique(support.begin(), support.end()), support.end());
+    return support;
+}
+
+// Mass of every degree goes to the largest support degree not above it
+std::vector<double> fold(const std::vector<double>& probabilities, const std::vector<size_t>& support)
+{
+    std::vector<double> folded(support.size(), 0.0);
+    for (auto idx = 0u; idx < probabilities.size(); ++idx)
+    {
+        auto it = std::upper_bound(support.cbegin(), support.cend(), idx + 1);
+        folded[static_cast<size_t>(std::distance(support.cbegin(), it)) - 1] += probabilities[idx];
+    }
+    return folded;
+}
+
+std::vector<double> expand(const std::vector<double>& weights, const std::vector<size_t>& support)
+{
+    std::vector<double> probabilities(support.back(), 0.0);
+    for (auto idx = 0u; idx < support.size(); ++idx)
+        probabilities[support[idx] - 1] = weights[idx];
+    return probabilities;
+}
+} // namespace
+
+double mean_overhead(const SeedSearch::DistributionFactory& distribution, size_t input_symbols, uint32_t first,
+                     size_t samples, const Options& options)
+{
+    SeedSearch::Options search;
+    search.trials = 0;
+    search.generator = options.generator;
+    search.threads = options.threads;
+    auto scores = SeedSearch::search_lt(distribution, input_symbols, first, samples, search);
+    if (scores.empty())
+        return 0.0;
+    auto total = std::accumulate(scores.cbegin(), scores.cend(), size_t{0},
+                                 [](size_t sum, const SeedSearch::Score& score) { return sum + score.lossless_overhead; });
+    return static_cast<double>(total) / static_cast<double>(scores.size());
+}
+
+Result optimize(size_t input_symbols, const Options& options, const std::vector<double>& initial)
+{
+    if (input_symbols == 0)
+        return {};
+    auto support = support_degrees(input_symbols, options.support);
+    auto weights = fold(initial.empty() ? IdealSolitonDistribution().expected_distribution(input_symbols) : initial,
+                        support);
+    auto evaluate = [&](const std::vector<double>& candidate) {
+        auto probabilities = expand(candidate, support);
+        return mean_overhead([&] { return new TabulatedDistribution(probabilities); }, input_symbols, 1,
+                             options.samples, options);
+    };
+
+    Result result;
+    result.mean_overhead = evaluate(weights);
+    xoshiro_256 proposals;
+    proposals.set_seed(options.seed);
+    for (size_t iteration = 0; iteration < options.iterations && support.size() > 1; ++iteration)
+    {
+        auto from = proposals() % support.size();
+        auto to = proposals() % (support.size() - 1);
+        to += to >= from;
+        if (weights[from] == 0.0)
+            continue;
+
+        auto candidate = weights;
+        auto amount = candidate[from] * options.step * proposals.rand_float();
+        candidate[from] -= amount;
+        candidate[to] += amount;
+        auto overhead = evaluate(candidate);
+        if (overhead < result.mean_overhead)
+        {
+            weights = std::move(candidate);
+            result.mean_overhead = overhead;
+            ++result.accepted;
+        }
+    }
+
+    auto sum = std::accumulate(weights.cbegin(), weights.cend(), 0.0);
+    for (auto& weight : weights)
+        weight /= sum;
+    result.probabilities = expand(weights, support);
+    return result;
+}
+} // namespace Codes::Fountain::DegreeOptimizer
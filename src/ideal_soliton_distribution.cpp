@@ -24,6 +24,11 @@ size_t IdealSolitonDistribution::symbol_degree()
     return value < _input_size ? std::ceil(value) : 1;
 }
 
+std::string IdealSolitonDistribution::key() const
+{
+    return "ideal";
+}
+
 std::vector<double> IdealSolitonDistribution::expected_distribution(size_t input_symbols)
 {
     std::vector<double> expected;
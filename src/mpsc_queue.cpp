@@ -0,0 +1,86 @@
+#include "mpsc_queue.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace Codes::Fountain {
+
+MpscSymbolQueue::MpscSymbolQueue(size_t capacity, size_t symbol_length)
+    : _symbol_length(symbol_length)
+{
+    capacity = std::bit_ceil(std::max<size_t>(capacity, 2));
+    _mask = capacity - 1;
+    _cells.reset(new Cell[capacity]);
+    _arena.reset(new char[capacity * symbol_length]);
+    for (size_t idx = 0; idx < capacity; ++idx)
+        _cells[idx].sequence.store(idx, std::memory_order_relaxed);
+}
+
+bool MpscSymbolQueue::push(const char* symbol, size_t number)
+{
+    auto pos = _enqueue.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    while (true)
+    {
+        cell = &_cells[pos & _mask];
+        auto sequence = cell->sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+        if (diff == 0)
+        {
+            if (_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (diff < 0)
+            return false;
+        else
+            pos = _enqueue.load(std::memory_order_relaxed);
+    }
+    memcpy(_arena.get() + (pos & _mask) * _symbol_length, symbol, _symbol_length);
+    cell->number = number;
+    cell->sequence.store(pos + 1);
+    if (_sleeping.exchange(false))
+        _sleeping.notify_one();
+    return true;
+}
+
+bool MpscSymbolQueue::empty() const
+{
+    return _cells[_dequeue & _mask].sequence.load() != _dequeue + 1;
+}
+
+void MpscSymbolQueue::wait()
+{
+    // a producer publishing after the store sees the flag, one publishing
+    // before it is seen by the empty() check
+    _sleeping.store(true);
+    if (!empty() || _shutdown)
+    {
+        _sleeping.store(false);
+        return;
+    }
+    _sleeping.wait(true);
+}
+
+void MpscSymbolQueue::shutdown()
+{
+    _shutdown = true;
+    _sleeping.store(false);
+    _sleeping.notify_one();
+}
+
+bool MpscSymbolQueue::is_shutdown() const
+{
+    return _shutdown;
+}
+
+size_t MpscSymbolQueue::capacity() const
+{
+    return _mask + 1;
+}
+
+size_t MpscSymbolQueue::symbol_length() const
+{
+    return _symbol_length;
+}
+} // namespace Codes::Fountain
\ No newline at end of file
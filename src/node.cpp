@@ -85,4 +85,19 @@ void Node::swap_with(Node& other)
     std::swap(_data, other._data);
     std::swap(_owner, other._owner);
 }
+
+std::unique_ptr<char[]> Node::take_data()
+{
+    if (!_owner)
+        _data.release();
+    _owner = true;
+    return std::move(_data);
+}
+
+void Node::reset()
+{
+    take_data();
+    _edges.clear();
+    _known = false;
+}
 } // namespace Codes::Fountain
\ No newline at end of file
@@ -0,0 +1,72 @@
+#include "recoder.h"
+
+#include "gf2.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Codes::Fountain {
+
+Recoder::Recoder(size_t input_symbols, size_t symbol_length, size_t capacity)
+    : _symbol_length(symbol_length)
+    , _row_words(GF2::words_for(input_symbols))
+    , _capacity(std::max<size_t>(capacity, 1))
+    , _xor(select_xor_kernel(symbol_length))
+{
+    _rows.resize(_capacity * _row_words);
+    _payloads.resize(_capacity * _symbol_length);
+    _mix.resize(GF2::words_for(_capacity));
+}
+
+void Recoder::set_seed(uint32_t seed)
+{
+    _generator.set_seed(seed);
+}
+
+void Recoder::set_generator(PrngType type)
+{
+    _generator.set_type(type);
+}
+
+size_t Recoder::row_words() const
+{
+    return _row_words;
+}
+
+size_t Recoder::size() const
+{
+    return _size;
+}
+
+bool Recoder::add_symbol(const char* data, const uint64_t* coefficients)
+{
+    if (GF2::count_bits(coefficients, _row_words) == 0)
+        return false;
+    memcpy(_rows.data() + _next * _row_words, coefficients, _row_words * sizeof(uint64_t));
+    memcpy(_payloads.data() + _next * _symbol_length, data, _symbol_length);
+    _next = (_next + 1) % _capacity;
+    _size = std::min(_size + 1, _capacity);
+    return true;
+}
+
+bool Recoder::recode(char* out, uint64_t* coefficients)
+{
+    if (_size == 0)
+        return false;
+    _generator.fill_bits(_mix.data(), _size);
+    // an empty mix would send nothing, take a single buffered symbol instead
+    if (GF2::count_bits(_mix.data(), GF2::words_for(_size)) == 0)
+        GF2::set_bit(_mix.data(), _generator() % _size);
+
+    memset(out, 0, _symbol_length);
+    std::fill_n(coefficients, _row_words, 0);
+    for (size_t idx = 0; idx < _size; ++idx)
+    {
+        if (!GF2::get_bit(_mix.data(), idx))
+            continue;
+        _xor(out, _payloads.data() + idx * _symbol_length, _symbol_length);
+        GF2::xor_row(coefficients, _rows.data() + idx * _row_words, _row_words);
+    }
+    return true;
+}
+} // namespace Codes::Fountain
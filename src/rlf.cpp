@@ -1,7 +1,14 @@
 #include "rlf.h"
 
+#include "code_graph.h"
+#include "crc32c.h"
+#include "gf2.h"
+#include "snapshot.h"
+
+#include <algorithm>
+#include <bit>
 #include <cstring>
-#include <span>
+#include <fstream>
 
 #include <spdlog/spdlog.h>
 
@@ -17,10 +24,17 @@ RLF::~RLF()
 
     for (const auto* hash_seq : _hash_bits)
         delete[] hash_seq;
+    for (const auto* hash_seq : _spare_rows)
+        delete[] hash_seq;
+    for (const auto* symbol : _spare_symbols)
+        delete[] symbol;
 
     for (int idx = 0; idx < _encoded_data.size(); ++idx)
         if (_encoded_data_copy[idx])
             delete[] _encoded_data[idx];
+    for (int idx = 0; idx < _source_data.size(); ++idx)
+        if (_source_data_copy[idx])
+            delete[] _source_data[idx];
 }
 
 void RLF::set_input_data(char* ptr, size_t len, bool deep_copy)
@@ -40,7 +54,9 @@ void RLF::set_input_data(char* ptr, size_t len, bool deep_copy)
 void RLF::set_symbol_length(size_t len)
 {
     _symbol_length = len;
+    _xor = select_xor_kernel(_symbol_length);
     _input_symbols = _input_data_size / _symbol_length;
+    _row_words = GF2::words_for(_input_symbols);
 }
 
 void RLF::set_input_data_size(size_t len)
@@ -48,88 +64,291 @@ void RLF::set_input_data_size(size_t len)
     _input_data_size = len;
 }
 
+void RLF::reset(uint32_t seed, size_t data_size, size_t symbol_length)
+{
+    auto keep_rows = GF2::words_for(data_size / symbol_length) == _row_words;
+    auto keep_symbols = symbol_length == _symbol_length;
+
+    for (auto* hash_seq : _hash_bits)
+        if (keep_rows)
+            _spare_rows.push_back(hash_seq);
+        else
+            delete[] hash_seq;
+    if (!keep_rows)
+    {
+        for (const auto* hash_seq : _spare_rows)
+            delete[] hash_seq;
+        _spare_rows.clear();
+    }
+    for (auto idx = 0; idx < _encoded_data.size(); ++idx)
+    {
+        if (!_encoded_data_copy[idx])
+            continue;
+        if (keep_symbols)
+            _spare_symbols.push_back(_encoded_data[idx]);
+        else
+            delete[] _encoded_data[idx];
+    }
+    for (auto idx = 0; idx < _source_data.size(); ++idx)
+    {
+        if (!_source_data_copy[idx])
+            continue;
+        if (keep_symbols)
+            _spare_symbols.push_back(_source_data[idx]);
+        else
+            delete[] _source_data[idx];
+    }
+    if (!keep_symbols)
+    {
+        for (const auto* symbol : _spare_symbols)
+            delete[] symbol;
+        _spare_symbols.clear();
+    }
+    _hash_bits.clear();
+    _encoded_data.clear();
+    _encoded_data_copy.clear();
+    _source_data.clear();
+    _source_data_copy.clear();
+    _solved.clear();
+
+    if (_owner)
+        delete[] _input_data;
+    _input_data = nullptr;
+    _owner = false;
+    // graph belongs to the previous (seed, K), set it again if still valid
+    _graph.reset();
+    _next_symbol = 0;
+    _decoded = false;
+    _stats.reset();
+
+    set_seed(seed);
+    set_input_data_size(data_size);
+    set_symbol_length(symbol_length);
+}
+
 char* RLF::generate_symbol()
 {
     auto* ptr = new char[_symbol_length];
-    memset(ptr, 0, _symbol_length);
-    auto* input = _input_data;
-
-    shuffle_input_symbols();
+    generate_symbol(_next_symbol++, ptr);
+    if (_streaming)
+        return ptr;
 
-    auto hash_sequence = new uint8_t[_input_symbols];
-    for (auto idx = 0; idx < _input_symbols; ++idx)
-        hash_sequence[idx] = _current_hash_bits[idx];
+    auto hash_sequence = acquire_row();
+    memcpy(hash_sequence, _current_hash_bits.data(), _row_words * sizeof(uint64_t));
     _hash_bits.push_back(hash_sequence);
 
+    return ptr;
+}
+
+void RLF::generate_symbol(size_t number, char* out)
+{
+    if (_systematic && number < _input_symbols)
+    {
+        load_symbol(number);
+        memcpy(out, _input_data + number * _symbol_length, _symbol_length);
+        return;
+    }
+    memset(out, 0, _symbol_length);
+    auto* input = _input_data;
+
+    load_symbol(number);
 
     for (auto idx = 0; idx < _input_symbols; ++idx)
     {
-        if (hash_sequence[idx])
-            for (auto sym_idx = 0; sym_idx < _symbol_length; ++sym_idx)
-                ptr[sym_idx] ^= input[sym_idx];
+        if (GF2::get_bit(_current_hash_bits.data(), idx))
+            _xor(out, input, _symbol_length);
         input += _symbol_length;
     };
+}
 
-    return ptr;
+void RLF::set_streaming(bool streaming)
+{
+    _streaming = streaming;
+}
+
+size_t RLF::next_symbol(char* out)
+{
+    auto number = _next_symbol++;
+    generate_symbol(number, out);
+    return number;
 }
 
 void RLF::set_seed(uint32_t seed)
 {
+    _seed = seed;
     _generator.set_seed(seed);
+    _current_symbol = 0;
+}
+
+void RLF::set_generator(PrngType type)
+{
+    _generator.set_type(type);
+}
+
+bool RLF::set_code_graph(std::shared_ptr<const CodeGraph> graph)
+{
+    if (graph && (graph->kind() != CodeGraph::Kind::Rlf ||
+                  (_input_symbols != 0 && graph->input_symbols() != _input_symbols)))
+        return false;
+    _graph = std::move(graph);
+    return true;
+}
+
+void RLF::set_systematic(bool systematic)
+{
+    _systematic = systematic;
 }
 
 void RLF::shuffle_input_symbols(bool discard)
 {
-    if (!discard)
+    if (discard)
+        _generator.discard_bits(_input_symbols);
+    else
     {
-        _current_hash_bits.resize(_input_symbols);
-        memset(_current_hash_bits.data(), 0, _input_symbols);
+        _current_hash_bits.resize(_row_words);
+        _generator.fill_bits(_current_hash_bits.data(), _input_symbols);
     }
-    for (auto idx = 0; idx < _input_symbols; ++idx)
-        if (!discard)
-            _current_hash_bits[idx] = _generator.rand_bit();
-        else
-            _generator.rand_bit();
     ++_current_symbol;
 }
 
+void RLF::load_symbol(size_t number)
+{
+    if (_systematic)
+    {
+        if (number < _input_symbols)
+        {
+            _current_hash_bits.assign(_row_words, 0);
+            GF2::set_bit(_current_hash_bits.data(), number);
+            _hash_bits_generated = false;
+            return;
+        }
+        number -= _input_symbols;
+    }
+    if (_graph && number < _graph->symbols() && _graph->matches(_seed, _input_symbols, _generator.type()))
+    {
+        auto* row = _graph->row(number);
+        _current_hash_bits.assign(row, row + _row_words);
+        _hash_bits_generated = false;
+        return;
+    }
+    // reloading the last generated symbol, its row is still there
+    if (number + 1 == _current_symbol && _hash_bits_generated)
+        return;
+    // graph did not advance the generator, catch up from its own position
+    if (number < _current_symbol)
+        set_seed(_seed);
+    while (_current_symbol != number + 1)
+        shuffle_input_symbols(_current_symbol != number);
+    _hash_bits_generated = true;
+}
+
+size_t RLF::row_words() const
+{
+    return _row_words;
+}
+
+void RLF::symbol_coefficients(size_t number, uint64_t* out)
+{
+    load_symbol(number);
+    memcpy(out, _current_hash_bits.data(), _row_words * sizeof(uint64_t));
+}
+
 void RLF::feed_symbol(char* ptr, size_t number, bool deep_copy)
 {
+    if (_systematic && number < _input_symbols)
+        return feed_source(ptr, number, deep_copy);
+    PhaseTimer timer(_stats, Phase::Feed);
+    load_symbol(number);
+    timer.stop();
+    feed_combination(ptr, _current_hash_bits.data(), deep_copy);
+}
+
+bool RLF::feed_tagged_symbol(char* ptr, size_t number, uint32_t tag, bool deep_copy)
+{
+    if (symbol_tag(ptr, _symbol_length, number) != tag)
+    {
+        ++_stats.corrupted_symbols;
+        return false;
+    }
+    feed_symbol(ptr, number, deep_copy);
+    return true;
+}
+
+void RLF::feed_combination(char* ptr, const uint64_t* coefficients, bool deep_copy)
+{
+    PhaseTimer timer(_stats, Phase::Feed);
+    ++_stats.symbols_received;
+    if (_decoded)
+        ++_stats.redundant_symbols;
     auto symbol = ptr;
     if (deep_copy)
     {
-        symbol = new char[_symbol_length];
+        symbol = acquire_symbol();
         memcpy(symbol, ptr, _symbol_length);
     }
     _encoded_data_copy.push_back(deep_copy);
     _encoded_data.push_back(symbol);
 
-    while (_current_symbol != number + 1)
-        shuffle_input_symbols(_current_symbol != number);
-
-    auto hash_sequence = new uint8_t[_input_symbols];
-    for (auto idx = 0; idx < _input_symbols; ++idx)
-        hash_sequence[idx] = _current_hash_bits[idx];
+    auto hash_sequence = acquire_row();
+    memcpy(hash_sequence, coefficients, _row_words * sizeof(uint64_t));
+    // relayed rows may carry junk past the last input, decoding walks every bit
+    if (_input_symbols % 64)
+        hash_sequence[_row_words - 1] &= (uint64_t(1) << (_input_symbols % 64)) - 1;
     _hash_bits.push_back(hash_sequence);
 }
 
+void RLF::feed_source(char* ptr, size_t number, bool deep_copy)
+{
+    PhaseTimer timer(_stats, Phase::Feed);
+    ++_stats.symbols_received;
+    if (_decoded)
+        ++_stats.redundant_symbols;
+    _source_data.resize(_input_symbols, nullptr);
+    _source_data_copy.resize(_input_symbols, false);
+    if (_source_data[number] != nullptr)
+    {
+        ++_stats.useless_symbols;
+        return;
+    }
+    auto symbol = ptr;
+    if (deep_copy)
+    {
+        symbol = acquire_symbol();
+        memcpy(symbol, ptr, _symbol_length);
+    }
+    _source_data[number] = symbol;
+    _source_data_copy[number] = deep_copy;
+}
+
+bool RLF::feed_symbols(std::span<SymbolPacket> packets, bool deep_copy)
+{
+    std::sort(packets.begin(), packets.end(),
+              [](const SymbolPacket& lhs, const SymbolPacket& rhs) { return lhs.number < rhs.number; });
+    for (const auto& packet : packets)
+        feed_symbol(packet.data, packet.number, deep_copy);
+    return decode();
+}
+
 bool RLF::decode(bool allow_partial)
 {
+    if (_systematic)
+        return decode_systematic(allow_partial);
     if (allow_partial == false && _hash_bits.size() < _input_symbols)
     {
         spdlog::trace("Partial decode not allowed and not enough symbols to perform full decode");
         return false;
     }
 
+    PhaseTimer eliminate_timer(_stats, Phase::Eliminate);
     for (auto idx = 0; idx < std::min(_input_symbols, _hash_bits.size()); ++idx)
     {
         // replace symbol to have 1 at nth position
-        if (_hash_bits[idx][idx] != 1)
+        if (!GF2::get_bit(_hash_bits[idx], idx))
         {
             int swap_idx = -1;
             for (auto candidate_idx = idx + 1; candidate_idx < _hash_bits.size(); ++candidate_idx)
             {
-                if (_hash_bits[candidate_idx][idx] != 0)
+                if (GF2::get_bit(_hash_bits[candidate_idx], idx))
                 {
                     swap_idx = candidate_idx;
                     break;
@@ -146,29 +365,32 @@ bool RLF::decode(bool allow_partial)
             std::swap(_encoded_data[swap_idx], _encoded_data[idx]);
             std::swap(_hash_bits[swap_idx], _hash_bits[idx]);
         }
+        ++_stats.pivots;
 
         // remove ones for all symbols that follows current
 
         for (auto following_idx = idx + 1; following_idx < _hash_bits.size(); ++following_idx)
         {
-            if (_hash_bits[following_idx][idx])
+            if (GF2::get_bit(_hash_bits[following_idx], idx))
             {
-                for (auto sym_idx = 0; sym_idx < _symbol_length; ++sym_idx)
-                    _encoded_data[following_idx][sym_idx] ^= _encoded_data[idx][sym_idx];
-                for (auto hash_idx = 0; hash_idx < _input_symbols; ++hash_idx)
-                    _hash_bits[following_idx][hash_idx] ^= _hash_bits[idx][hash_idx];
+                _xor(_encoded_data[following_idx], _encoded_data[idx], _symbol_length);
+                GF2::xor_row(_hash_bits[following_idx], _hash_bits[idx], _row_words);
+                ++_stats.row_operations;
+                _stats.bytes_xored += _symbol_length;
             }
         }
     }
+    eliminate_timer.stop();
 #if defined(ENABLE_TRACE_LOG)
     spdlog::trace("after triangle");
     print_hash_matrix();
 #endif
     auto valid_traingle_matrix = _encoded_data.size() >= _input_symbols;
+    PhaseTimer back_substitute_timer(_stats, Phase::BackSubstitute);
 
     for (auto idx = size_t{0}; idx < std::min(_encoded_data.size(), _input_symbols); ++idx)
     {
-        if (_hash_bits[idx][idx] != 1)
+        if (!GF2::get_bit(_hash_bits[idx], idx))
         {
             spdlog::trace("Invalid triangle matrix at idx {}", idx);
             valid_traingle_matrix = false;
@@ -176,12 +398,12 @@ bool RLF::decode(bool allow_partial)
         }
         for (auto preceding_idx = 0; preceding_idx < std::min(_encoded_data.size(), idx); ++preceding_idx)
         {
-            if (_hash_bits[preceding_idx][idx])
+            if (GF2::get_bit(_hash_bits[preceding_idx], idx))
             {
-                for (auto sym_idx = 0; sym_idx < _symbol_length; ++sym_idx)
-                    _encoded_data[preceding_idx][sym_idx] ^= _encoded_data[idx][sym_idx];
-                for (auto hash_idx = 0; hash_idx < _input_symbols; ++hash_idx)
-                    _hash_bits[preceding_idx][hash_idx] ^= _hash_bits[idx][hash_idx];
+                _xor(_encoded_data[preceding_idx], _encoded_data[idx], _symbol_length);
+                GF2::xor_row(_hash_bits[preceding_idx], _hash_bits[idx], _row_words);
+                ++_stats.row_operations;
+                _stats.bytes_xored += _symbol_length;
             }
         }
     }
@@ -189,20 +411,261 @@ bool RLF::decode(bool allow_partial)
     spdlog::trace("after back subs");
     print_hash_matrix();
 #endif
+    back_substitute_timer.stop();
+    if (valid_traingle_matrix && !_decoded)
+    {
+        _decoded = true;
+        // rows that did not end up as a pivot carried no new information
+        _stats.useless_symbols = _hash_bits.size() - _input_symbols;
+    }
     return valid_traingle_matrix;
 }
 
+bool RLF::decode_systematic(bool allow_partial)
+{
+    _source_data.resize(_input_symbols, nullptr);
+    _source_data_copy.resize(_input_symbols, false);
+    std::vector<size_t> missing;
+    for (auto idx = size_t{0}; idx < _input_symbols; ++idx)
+        if (_source_data[idx] == nullptr)
+            missing.push_back(idx);
+    if (allow_partial == false && _hash_bits.size() < missing.size())
+    {
+        spdlog::trace("Partial decode not allowed and not enough repair symbols for {} missing", missing.size());
+        return false;
+    }
+
+    PhaseTimer eliminate_timer(_stats, Phase::Eliminate);
+    // received inputs are substituted into repair rows, so the rows are left
+    // with coefficients for missing columns only
+    for (auto idx = size_t{0}; idx < _hash_bits.size(); ++idx)
+    {
+        auto* row = _hash_bits[idx];
+        for (auto word = size_t{0}; word < _row_words; ++word)
+            for (auto bits = row[word]; bits != 0; bits &= bits - 1)
+            {
+                auto column = word * 64 + static_cast<size_t>(std::countr_zero(bits));
+                if (_source_data[column] == nullptr)
+                    continue;
+                _xor(_encoded_data[idx], _source_data[column], _symbol_length);
+                GF2::clear_bit(row, column);
+                _stats.bytes_xored += _symbol_length;
+            }
+    }
+
+    // Gauss-Jordan over the missing columns, row idx ends up solving missing[idx]
+    for (auto idx = size_t{0}; idx < missing.size(); ++idx)
+    {
+        auto column = missing[idx];
+        auto pivot = idx;
+        while (pivot < _hash_bits.size() && !GF2::get_bit(_hash_bits[pivot], column))
+            ++pivot;
+        if (pivot == _hash_bits.size())
+        {
+            spdlog::trace("Can not find repair symbol for missing idx {}", column);
+            return false;
+        }
+        std::swap(_encoded_data[pivot], _encoded_data[idx]);
+        std::swap(_hash_bits[pivot], _hash_bits[idx]);
+        std::vector<bool>::swap(_encoded_data_copy[pivot], _encoded_data_copy[idx]);
+        ++_stats.pivots;
+
+        for (auto other_idx = size_t{0}; other_idx < _hash_bits.size(); ++other_idx)
+        {
+            if (other_idx == idx || !GF2::get_bit(_hash_bits[other_idx], column))
+                continue;
+            _xor(_encoded_data[other_idx], _encoded_data[idx], _symbol_length);
+            GF2::xor_row(_hash_bits[other_idx], _hash_bits[idx], _row_words);
+            ++_stats.row_operations;
+            _stats.bytes_xored += _symbol_length;
+        }
+    }
+    eliminate_timer.stop();
+
+    _solved = _source_data;
+    for (auto idx = size_t{0}; idx < missing.size(); ++idx)
+        _solved[missing[idx]] = _encoded_data[idx];
+    if (!_decoded)
+    {
+        _decoded = true;
+        _stats.useless_symbols += _hash_bits.size() - missing.size();
+    }
+    return true;
+}
+
 char* RLF::decoded_buffer()
 {
+    if (!_decoded)
+        return nullptr;
     auto buffer = new char[_input_data_size];
+    if (_systematic)
+    {
+        for (auto idx = 0; idx < _input_symbols; ++idx)
+            memcpy(buffer + idx * _symbol_length, _solved[idx], _symbol_length);
+        return buffer;
+    }
     for (auto idx = 0; idx < _input_symbols; ++idx)
         memcpy(buffer + idx * _symbol_length, _encoded_data[idx], _symbol_length);
     return buffer;
 }
 
+bool RLF::save_snapshot(const std::string& path) const
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        return false;
+
+    Snapshot::Header header;
+    header.kind = Snapshot::Kind::RLF;
+    header.seed = _seed;
+    header.generator = static_cast<uint32_t>(_generator.type());
+    header.flags = _systematic ? Snapshot::systematic_flag : 0;
+    header.data_size = _input_data_size;
+    header.symbol_length = _symbol_length;
+    Snapshot::write_header(out, header, std::string());
+    Snapshot::write_stats(out, _stats);
+
+    uint64_t rows = _hash_bits.size();
+    Snapshot::write(out, rows);
+    auto row_length = static_cast<std::streamsize>(_row_words * sizeof(uint64_t));
+    auto length = static_cast<std::streamsize>(_symbol_length);
+    for (auto idx = size_t{0}; idx < _hash_bits.size(); ++idx)
+    {
+        out.write(reinterpret_cast<const char*>(_hash_bits[idx]), row_length);
+        out.write(_encoded_data[idx], length);
+    }
+    auto sources = std::count_if(_source_data.cbegin(), _source_data.cend(),
+                                 [](const char* source) { return source != nullptr; });
+    Snapshot::write(out, static_cast<uint64_t>(sources));
+    for (auto idx = uint64_t{0}; idx < _source_data.size(); ++idx)
+    {
+        if (_source_data[idx] == nullptr)
+            continue;
+        Snapshot::write(out, idx);
+        out.write(_source_data[idx], length);
+    }
+    return static_cast<bool>(out.flush());
+}
+
+bool RLF::load_snapshot(const std::string& path)
+{
+    std::ifstream in(path, std::ios::binary);
+    Snapshot::Header header;
+    std::string key;
+    DecoderStats stats;
+    if (!in || !Snapshot::read_header(in, Snapshot::Kind::RLF, header, key) || header.symbol_length == 0 ||
+        !Snapshot::read_stats(in, stats))
+        return false;
+
+    // whole snapshot is read before the decoder is touched, a broken file
+    // leaves it as it was
+    auto input_symbols = header.data_size / header.symbol_length;
+    auto row_words = GF2::words_for(input_symbols);
+    auto length = static_cast<std::streamsize>(header.symbol_length);
+    uint64_t rows = 0;
+    if (!Snapshot::read(in, rows))
+        return false;
+    std::vector<uint64_t> row_bits;
+    std::vector<char> row_payloads;
+    for (uint64_t row = 0; row < rows; ++row)
+    {
+        row_bits.resize((row + 1) * row_words);
+        row_payloads.resize((row + 1) * header.symbol_length);
+        if (!in.read(reinterpret_cast<char*>(row_bits.data() + row * row_words),
+                     static_cast<std::streamsize>(row_words * sizeof(uint64_t))) ||
+            !in.read(row_payloads.data() + row * header.symbol_length, length))
+            return false;
+    }
+
+    uint64_t sources = 0;
+    if (!Snapshot::read(in, sources))
+        return false;
+    std::vector<uint64_t> source_indices;
+    std::vector<char> source_payloads;
+    std::vector<bool> seen(sources != 0 ? input_symbols : 0);
+    for (uint64_t source = 0; source < sources; ++source)
+    {
+        uint64_t idx = 0;
+        if (!Snapshot::read(in, idx) || idx >= input_symbols || seen[idx])
+            return false;
+        seen[idx] = true;
+        source_indices.push_back(idx);
+        source_payloads.resize((source + 1) * header.symbol_length);
+        if (!in.read(source_payloads.data() + source * header.symbol_length, length))
+            return false;
+    }
+
+    set_generator(static_cast<PrngType>(header.generator));
+    set_systematic(header.flags & Snapshot::systematic_flag);
+    reset(header.seed, header.data_size, header.symbol_length);
+    stats.timers_enabled = _stats.timers_enabled;
+    _stats = stats;
+
+    for (size_t row = 0; row < rows; ++row)
+    {
+        _hash_bits.push_back(acquire_row());
+        _encoded_data.push_back(acquire_symbol());
+        _encoded_data_copy.push_back(true);
+        std::copy_n(row_bits.data() + row * _row_words, _row_words, _hash_bits.back());
+        memcpy(_encoded_data.back(), row_payloads.data() + row * _symbol_length, _symbol_length);
+    }
+    if (sources != 0)
+    {
+        _source_data.resize(_input_symbols, nullptr);
+        _source_data_copy.resize(_input_symbols, false);
+    }
+    for (size_t source = 0; source < source_indices.size(); ++source)
+    {
+        auto idx = source_indices[source];
+        _source_data[idx] = acquire_symbol();
+        _source_data_copy[idx] = true;
+        memcpy(_source_data[idx], source_payloads.data() + source * _symbol_length, _symbol_length);
+    }
+
+    // a torn append at the end is where the journal stops
+    std::vector<char> payload(_symbol_length);
+    uint64_t number = 0;
+    while (Snapshot::read_symbol(in, _symbol_length, number, payload.data()))
+        feed_symbol(payload.data(), number, true);
+    return true;
+}
+
+const DecoderStats& RLF::stats() const
+{
+    return _stats;
+}
+
+DecoderStats& RLF::stats()
+{
+    return _stats;
+}
+
+uint64_t* RLF::acquire_row()
+{
+    if (_spare_rows.empty())
+        return new uint64_t[_row_words];
+    auto* row = _spare_rows.back();
+    _spare_rows.pop_back();
+    return row;
+}
+
+char* RLF::acquire_symbol()
+{
+    if (_spare_symbols.empty())
+        return new char[_symbol_length];
+    auto* symbol = _spare_symbols.back();
+    _spare_symbols.pop_back();
+    return symbol;
+}
+
 void RLF::print_hash_matrix()
 {
+    std::vector<int> row(_input_symbols);
     for (auto idx = 0; idx < _hash_bits.size(); ++idx)
-        spdlog::trace("{} {} ", idx, fmt::join(std::span(_hash_bits[idx], _input_symbols), ", "));
+    {
+        for (auto bit_idx = 0; bit_idx < _input_symbols; ++bit_idx)
+            row[bit_idx] = GF2::get_bit(_hash_bits[idx], bit_idx);
+        spdlog::trace("{} {} ", idx, fmt::join(row, ", "));
+    }
 }
 } // namespace Codes::Fountain
\ No newline at end of file
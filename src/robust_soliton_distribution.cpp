@@ -4,6 +4,7 @@
 
 #include <cmath>
 #include <numeric>
+#include <sstream>
 
 namespace Codes::Fountain {
 
@@ -20,22 +21,20 @@ void RobustSolitonDistribution::set_seed(uint32_t seed)
 void RobustSolitonDistribution::set_input_size(size_t input_symbols)
 {
     _input_size = input_symbols;
-    auto probabilities = expected_distribution(_input_size);
-    _cumulative_probabilities.resize(_input_size);
-    auto cumulative_value = 0.0;
-    for (auto idx = 0u; idx < _input_size; ++idx)
-    {
-        cumulative_value += probabilities[idx];
-        _cumulative_probabilities[idx] = cumulative_value;
-    }
+    _cumulative_probabilities = cumulative_probabilities(expected_distribution(_input_size), _input_size);
 }
 
 size_t RobustSolitonDistribution::symbol_degree()
 {
-    auto value = _degree_dist.rand_float();
-    auto it = std::lower_bound(_cumulative_probabilities.cbegin(), _cumulative_probabilities.cend(), value);
-    return it == _cumulative_probabilities.cend() ? _cumulative_probabilities.size()
-                                                  : std::distance(_cumulative_probabilities.cbegin(), it) + 1;
+    return sample_degree(_cumulative_probabilities, _degree_dist.rand_float());
+}
+
+std::string RobustSolitonDistribution::key() const
+{
+    std::ostringstream stream;
+    stream.precision(17);
+    stream << "robust:" << _delta << ":" << _c;
+    return stream.str();
 }
 
 std::vector<double> RobustSolitonDistribution::expected_distribution(size_t input_symbols)
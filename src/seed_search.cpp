@@ -0,0 +1,350 @@
+#include "seed_search.h"
+
+#include "gf2.h"
+#include "lt.h"
+#include "rlf.h"
+#include "robust_soliton_distribution.h"
+#include "thread_pool.h"
+#include "xoshiro256.h"
+
+#include <algorithm>
+#include <bit>
+#include <latch>
+#include <span>
+#include <tuple>
+
+namespace Codes::Fountain::SeedSearch {
+
+namespace {
+// Rows are generated by the codec itself and kept for all trials of a seed
+class RlfRows
+{
+public:
+    RlfRows(uint32_t seed, size_t input_symbols, PrngType type)
+    {
+        _builder.set_generator(type);
+        _builder.set_seed(seed);
+        _builder.set_input_data_size(input_symbols);
+        _builder.set_symbol_length(1);
+    }
+
+    size_t words() const
+    {
+        return _builder._row_words;
+    }
+
+    const uint64_t* get(size_t number)
+    {
+        for (auto generated = _rows.size() / words(); generated <= number; ++generated)
+        {
+            _builder.load_symbol(generated);
+            _rows.insert(_rows.end(), _builder._current_hash_bits.cbegin(), _builder._current_hash_bits.cend());
+        }
+        return _rows.data() + number * words();
+    }
+
+private:
+    RLF _builder;
+    std::vector<uint64_t> _rows;
+};
+
+// Echelon basis keyed by the lowest set bit of every stored row
+class RankTracker
+{
+public:
+    RankTracker(size_t input_symbols, size_t words)
+        : _input_symbols(input_symbols)
+        , _words(words)
+        , _basis(input_symbols * words)
+        , _pivots(input_symbols)
+        , _row(words)
+    {}
+
+    void reset()
+    {
+        std::fill(_pivots.begin(), _pivots.end(), false);
+        _rank = 0;
+    }
+
+    bool add(const uint64_t* row)
+    {
+        std::copy(row, row + _words, _row.begin());
+        for (size_t word = 0; word < _words;)
+        {
+            if (_row[word] == 0)
+            {
+                ++word;
+                continue;
+            }
+            auto column = word * 64 + static_cast<size_t>(std::countr_zero(_row[word]));
+            auto* pivot = _basis.data() + column * _words;
+            if (!_pivots[column])
+            {
+                std::copy(_row.begin(), _row.end(), pivot);
+                _pivots[column] = true;
+                ++_rank;
+                break;
+            }
+            // pivot row starts at column, so only words from here on change
+            GF2::xor_row(_row.data() + word, pivot + word, _words - word);
+        }
+        return _rank == _input_symbols;
+    }
+
+private:
+    size_t _input_symbols;
+    size_t _words;
+    std::vector<uint64_t> _basis;
+    std::vector<bool> _pivots;
+    std::vector<uint64_t> _row;
+    size_t _rank = 0;
+};
+
+class LtRows
+{
+public:
+    LtRows(DegreeDistribution* distribution, uint32_t seed, size_t input_symbols, PrngType type)
+        : _builder(distribution)
+    {
+        _builder.set_generator(type);
+        _builder.set_seed(seed);
+        _builder.set_input_data_size(input_symbols);
+        _builder.set_symbol_length(1);
+    }
+
+    std::span<const uint32_t> get(size_t number)
+    {
+        for (auto generated = _offsets.size() - 1; generated <= number; ++generated)
+        {
+            _builder.load_symbol(generated);
+            _neighbors.insert(_neighbors.end(), _builder._current_hash_bits.cbegin(),
+                              _builder._current_hash_bits.cend());
+            _offsets.push_back(_neighbors.size());
+        }
+        return std::span(_neighbors.data() + _offsets[number], _offsets[number + 1] - _offsets[number]);
+    }
+
+private:
+    LT _builder;
+    std::vector<size_t> _offsets{0};
+    std::vector<uint32_t> _neighbors;
+};
+
+// Peeling on indices, every droplet keeps its count of unknown neighbors and
+// their XOR, which is the last neighbor once the count drops to one
+class Peeler
+{
+public:
+    explicit Peeler(size_t input_symbols)
+        : _known(input_symbols)
+        , _edges(input_symbols)
+    {}
+
+    void reset()
+    {
+        std::fill(_known.begin(), _known.end(), false);
+        for (auto& edges : _edges)
+            edges.clear();
+        _degree.clear();
+        _rest.clear();
+        _recovered = 0;
+    }
+
+    bool add(std::span<const uint32_t> neighbors)
+    {
+        size_t degree = 0;
+        uint32_t rest = 0;
+        for (auto input : neighbors)
+            if (!_known[input])
+            {
+                ++degree;
+                rest ^= input;
+            }
+        if (degree == 1)
+            recover(rest);
+        else if (degree > 1)
+        {
+            auto droplet = _degree.size();
+            _degree.push_back(degree);
+            _rest.push_back(rest);
+            for (auto input : neighbors)
+                if (!_known[input])
+                    _edges[input].push_back(droplet);
+        }
+        return _recovered == _known.size();
+    }
+
+private:
+    void recover(uint32_t input)
+    {
+        _ripple.assign(1, input);
+        while (!_ripple.empty())
+        {
+            auto next = _ripple.back();
+            _ripple.pop_back();
+            if (_known[next])
+                continue;
+            _known[next] = true;
+            ++_recovered;
+            for (auto droplet : _edges[next])
+            {
+                _rest[droplet] ^= next;
+                if (--_degree[droplet] == 1)
+                    _ripple.push_back(_rest[droplet]);
+            }
+            _edges[next].clear();
+        }
+    }
+
+    std::vector<bool> _known;
+    std::vector<std::vector<size_t>> _edges;
+    std::vector<size_t> _degree;
+    std::vector<uint32_t> _rest;
+    std::vector<uint32_t> _ripple;
+    size_t _recovered = 0;
+};
+
+template <typename Rows, typename Decoder>
+Score simulate(uint32_t seed, size_t input_symbols, const Options& options, Rows& rows, Decoder& decoder)
+{
+    auto limit = options.max_overhead != 0 ? options.max_overhead : input_symbols;
+    auto loss = std::clamp(options.loss, 0.0, 0.99);
+    auto overhead = [&](auto&& keep) {
+        decoder.reset();
+        size_t received = 0;
+        for (size_t number = 0; received < input_symbols + limit; ++number)
+        {
+            if (!keep())
+                continue;
+            ++received;
+            if (decoder.add(rows.get(number)))
+                return received - input_symbols;
+        }
+        return limit + 1;
+    };
+
+    Score score;
+    score.seed = seed;
+    score.lossless_overhead = overhead([] { return true; });
+    score.max_overhead = score.lossless_overhead;
+    score.mean_overhead = static_cast<double>(score.lossless_overhead);
+    if (options.trials == 0)
+        return score;
+
+    size_t total = 0;
+    for (size_t trial = 0; trial < options.trials; ++trial)
+    {
+        xoshiro_256 erasures;
+        erasures.set_seed(static_cast<uint32_t>(trial));
+        auto value = overhead([&] { return erasures.rand_float() >= loss; });
+        total += value;
+        score.max_overhead = std::max(score.max_overhead, value);
+    }
+    score.mean_overhead = static_cast<double>(total) / static_cast<double>(options.trials);
+    return score;
+}
+
+template <typename Scorer>
+std::vector<Score> search(uint32_t first, size_t count, const Options& options, Scorer scorer)
+{
+    std::vector<uint32_t> seeds;
+    for (size_t idx = 0; idx < count; ++idx)
+        if (auto seed = static_cast<uint32_t>(first + idx); seed != 0)
+            seeds.push_back(seed);
+
+    std::vector<Score> scores(seeds.size());
+    {
+        ThreadPool pool(std::max<size_t>(options.threads, 1));
+        std::latch done(static_cast<std::ptrdiff_t>(seeds.size()));
+        for (size_t idx = 0; idx < seeds.size(); ++idx)
+            pool.post([&, idx] {
+                scores[idx] = scorer(seeds[idx]);
+                done.count_down();
+            });
+        done.wait();
+    }
+    std::sort(scores.begin(), scores.end(), better);
+    return scores;
+}
+} // namespace
+
+Score score_rlf(uint32_t seed, size_t input_symbols, const Options& options)
+{
+    RlfRows rows(seed, input_symbols, options.generator);
+    RankTracker decoder(input_symbols, rows.words());
+    return simulate(seed, input_symbols, options, rows, decoder);
+}
+
+Score score_lt(const DistributionFactory& distribution, uint32_t seed, size_t input_symbols, const Options& options)
+{
+    LtRows rows(distribution(), seed, input_symbols, options.generator);
+    Peeler decoder(input_symbols);
+    return simulate(seed, input_symbols, options, rows, decoder);
+}
+
+std::vector<Score> search_rlf(size_t input_symbols, uint32_t first, size_t count, const Options& options)
+{
+    return search(first, count, options, [&](uint32_t seed) { return score_rlf(seed, input_symbols, options); });
+}
+
+std::vector<Score> search_lt(const DistributionFactory& distribution, size_t input_symbols, uint32_t first,
+                             size_t count, const Options& options)
+{
+    return search(first, count, options,
+                  [&](uint32_t seed) { return score_lt(distribution, seed, input_symbols, options); });
+}
+
+bool better(const Score& lhs, const Score& rhs)
+{
+    return std::tie(lhs.lossless_overhead, lhs.mean_overhead, lhs.max_overhead, lhs.seed) <
+           std::tie(rhs.lossless_overhead, rhs.mean_overhead, rhs.max_overhead, rhs.seed);
+}
+
+const std::vector<Recommendation>& recommendations()
+{
+    // Best of seeds 1..2000 (1..30 at K = 1024) with 10% loss trials, LT uses
+    // RobustSolitonDistribution(0.05, 0.03)
+    static const std::string robust_key = RobustSolitonDistribution(0.05, 0.03).key();
+    static const char* robust = robust_key.c_str();
+    static const std::vector<Recommendation> table{
+        {CodeGraph::Kind::Rlf, PrngType::Well512, "", 16, 550, 3},
+        {CodeGraph::Kind::Rlf, PrngType::Well512, "", 32, 1593, 8},
+        {CodeGraph::Kind::Rlf, PrngType::Well512, "", 64, 615, 3},
+        {CodeGraph::Kind::Rlf, PrngType::Well512, "", 128, 678, 0},
+        {CodeGraph::Kind::Rlf, PrngType::Well512, "", 256, 214, 0},
+        {CodeGraph::Kind::Rlf, PrngType::Well512, "", 512, 60, 0},
+        {CodeGraph::Kind::Rlf, PrngType::Xoshiro256, "", 16, 566, 0},
+        {CodeGraph::Kind::Rlf, PrngType::Xoshiro256, "", 32, 1477, 0},
+        {CodeGraph::Kind::Rlf, PrngType::Xoshiro256, "", 64, 1302, 0},
+        {CodeGraph::Kind::Rlf, PrngType::Xoshiro256, "", 128, 120, 0},
+        {CodeGraph::Kind::Rlf, PrngType::Xoshiro256, "", 256, 50, 0},
+        {CodeGraph::Kind::Rlf, PrngType::Xoshiro256, "", 512, 76, 0},
+        {CodeGraph::Kind::Rlf, PrngType::Xoshiro256, "", 1024, 19, 0},
+        {CodeGraph::Kind::Lt, PrngType::Well512, robust, 16, 1292, 0},
+        {CodeGraph::Kind::Lt, PrngType::Well512, robust, 32, 1044, 1},
+        {CodeGraph::Kind::Lt, PrngType::Well512, robust, 64, 849, 5},
+        {CodeGraph::Kind::Lt, PrngType::Well512, robust, 128, 311, 8},
+        {CodeGraph::Kind::Lt, PrngType::Well512, robust, 256, 232, 25},
+        {CodeGraph::Kind::Lt, PrngType::Well512, robust, 512, 22, 46},
+        {CodeGraph::Kind::Lt, PrngType::Well512, robust, 1024, 12, 69},
+        {CodeGraph::Kind::Lt, PrngType::Xoshiro256, robust, 16, 1933, 0},
+        {CodeGraph::Kind::Lt, PrngType::Xoshiro256, robust, 32, 1329, 1},
+        {CodeGraph::Kind::Lt, PrngType::Xoshiro256, robust, 64, 321, 3},
+        {CodeGraph::Kind::Lt, PrngType::Xoshiro256, robust, 128, 181, 10},
+        {CodeGraph::Kind::Lt, PrngType::Xoshiro256, robust, 256, 59, 26},
+        {CodeGraph::Kind::Lt, PrngType::Xoshiro256, robust, 512, 73, 50},
+        {CodeGraph::Kind::Lt, PrngType::Xoshiro256, robust, 1024, 22, 84},
+    };
+    return table;
+}
+
+std::optional<Recommendation> recommended_seed(CodeGraph::Kind kind, size_t input_symbols, PrngType generator,
+                                               const std::string& distribution)
+{
+    for (const auto& entry : recommendations())
+        if (entry.kind == kind && entry.generator == generator && entry.input_symbols == input_symbols &&
+            entry.distribution == distribution)
+            return entry;
+    return std::nullopt;
+}
+} // namespace Codes::Fountain::SeedSearch
@@ -0,0 +1,142 @@
+#include "session_scheduler.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+
+namespace Codes::Fountain {
+
+SessionScheduler::SessionScheduler(size_t threads, size_t max_batch)
+    : _max_batch(std::max<size_t>(max_batch, 1))
+    , _pool(threads)
+{}
+
+SessionScheduler::~SessionScheduler()
+{
+    std::unique_lock lock(_sessions_mutex);
+    for (auto& [id, state] : _sessions)
+    {
+        std::lock_guard state_lock(state->mutex);
+        finish(*state, false);
+    }
+}
+
+std::future<bool> SessionScheduler::open(size_t id, std::unique_ptr<DecodeSession> session, Callback on_complete)
+{
+    auto state = std::make_shared<State>();
+    state->id = id;
+    state->session = std::move(session);
+    state->on_complete = std::move(on_complete);
+    auto future = state->promise.get_future();
+
+    std::unique_lock lock(_sessions_mutex);
+    auto& slot = _sessions[id];
+    if (slot)
+    {
+        std::lock_guard state_lock(slot->mutex);
+        finish(*slot, false);
+    }
+    slot = std::move(state);
+    return future;
+}
+
+bool SessionScheduler::submit(size_t id, const char* symbol, size_t symbol_length, size_t number)
+{
+    auto state = find(id);
+    if (!state)
+        return false;
+
+    Packet packet{std::unique_ptr<char[]>(new char[symbol_length]), number};
+    memcpy(packet.data.get(), symbol, symbol_length);
+
+    std::lock_guard lock(state->mutex);
+    if (state->finished)
+        return false;
+    state->queue.push_back(std::move(packet));
+    if (!state->scheduled)
+    {
+        state->scheduled = true;
+        _pool.post([this, state] { process(state); });
+    }
+    return true;
+}
+
+void SessionScheduler::close(size_t id)
+{
+    std::shared_ptr<State> state;
+    {
+        std::unique_lock lock(_sessions_mutex);
+        auto it = _sessions.find(id);
+        if (it == _sessions.end())
+            return;
+        state = std::move(it->second);
+        _sessions.erase(it);
+    }
+    std::lock_guard lock(state->mutex);
+    finish(*state, false);
+}
+
+size_t SessionScheduler::sessions() const
+{
+    std::shared_lock lock(_sessions_mutex);
+    return _sessions.size();
+}
+
+std::shared_ptr<SessionScheduler::State> SessionScheduler::find(size_t id) const
+{
+    std::shared_lock lock(_sessions_mutex);
+    auto it = _sessions.find(id);
+    return it == _sessions.end() ? nullptr : it->second;
+}
+
+void SessionScheduler::finish(State& state, bool decoded)
+{
+    if (state.finished)
+        return;
+    state.finished = true;
+    state.queue.clear();
+    state.promise.set_value(decoded);
+}
+
+void SessionScheduler::process(const std::shared_ptr<State>& state)
+{
+    std::vector<Packet> batch;
+    {
+        std::lock_guard lock(state->mutex);
+        if (state->finished)
+        {
+            state->scheduled = false;
+            return;
+        }
+        auto count = static_cast<std::ptrdiff_t>(std::min(_max_batch, state->queue.size()));
+        std::move(state->queue.begin(), state->queue.begin() + count, std::back_inserter(batch));
+        state->queue.erase(state->queue.begin(), state->queue.begin() + count);
+    }
+
+    // only this task touches the session, scheduled flag keeps others out
+    for (auto& packet : batch)
+        state->session->feed(std::move(packet.data), packet.number);
+    auto decoded = state->session->decode();
+
+    std::unique_lock lock(state->mutex);
+    if (decoded && !state->finished)
+    {
+        // session is finished before the callback runs, a racing close()
+        // leaves it alone and the future still reports the decode
+        state->finished = true;
+        state->scheduled = false;
+        state->queue.clear();
+        lock.unlock();
+        if (state->on_complete)
+            state->on_complete(state->id, *state->session);
+        state->promise.set_value(true);
+        return;
+    }
+    if (state->finished || state->queue.empty())
+    {
+        state->scheduled = false;
+        return;
+    }
+    _pool.post([this, state] { process(state); });
+}
+} // namespace Codes::Fountain
\ No newline at end of file
@@ -0,0 +1,275 @@
+#include "sliding_window_rlf.h"
+
+#include "gf2.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Codes::Fountain {
+
+SlidingWindowRLF::SlidingWindowRLF(size_t window, size_t symbol_length, size_t capacity)
+    : _window(std::max<size_t>(window, 1))
+    , _symbol_length(symbol_length)
+{
+    capacity = std::max(capacity == 0 ? 4 * _window : capacity, _window);
+    _row_words = GF2::words_for(capacity);
+    _capacity = _row_words * 64;
+    _xor = select_xor_kernel(_symbol_length);
+
+    _sources.resize(_window * _symbol_length);
+    _slots.assign(_capacity, Slot::Empty);
+    _given_up.assign(_capacity, false);
+    _rows.assign(_capacity * _row_words, 0);
+    _payloads.resize(_capacity * _symbol_length);
+    _current_row.resize(_row_words);
+    _current_payload.resize(_symbol_length);
+}
+
+void SlidingWindowRLF::set_seed(uint32_t seed)
+{
+    _seed = seed;
+}
+
+void SlidingWindowRLF::set_generator(PrngType type)
+{
+    _generator.set_type(type);
+}
+
+size_t SlidingWindowRLF::push_source(const char* data)
+{
+    memcpy(_sources.data() + (_pushed % _window) * _symbol_length, data, _symbol_length);
+    return _pushed++;
+}
+
+WindowSymbol SlidingWindowRLF::generate_symbol(char* out)
+{
+    WindowSymbol header;
+    header.number = _next_symbol++;
+    header.count = std::min(_window, _pushed);
+    header.first = _pushed - header.count;
+
+    load_coefficients(header.number, header.count);
+    memset(out, 0, _symbol_length);
+    for (size_t idx = 0; idx < header.count; ++idx)
+        if (GF2::get_bit(_current_hash_bits.data(), idx))
+            _xor(out, source_symbol(header.first + idx), _symbol_length);
+    return header;
+}
+
+const char* SlidingWindowRLF::source_symbol(size_t index) const
+{
+    return _sources.data() + (index % _window) * _symbol_length;
+}
+
+// Every symbol gets its own generator state, so lost symbols do not have
+// to be caught up with
+void SlidingWindowRLF::load_coefficients(size_t number, size_t count)
+{
+    _current_hash_bits.assign(GF2::words_for(count), 0);
+    if (count == 0)
+        return;
+    _generator.set_seed(_seed ^ static_cast<uint32_t>((number * 0x9E3779B97F4A7C15ULL) >> 32));
+    _generator.fill_bits(_current_hash_bits.data(), count);
+    if (GF2::count_bits(_current_hash_bits.data(), _current_hash_bits.size()) == 0)
+        GF2::set_bit(_current_hash_bits.data(), count - 1);
+}
+
+void SlidingWindowRLF::set_delivery(Delivery delivery)
+{
+    _delivery = std::move(delivery);
+}
+
+bool SlidingWindowRLF::feed_source(size_t index, const char* data)
+{
+    _current_hash_bits.assign(1, 1);
+    return feed_row(data, index, 1);
+}
+
+bool SlidingWindowRLF::feed_symbol(const char* data, const WindowSymbol& header)
+{
+    load_coefficients(header.number, header.count);
+    return feed_row(data, header.first, header.count);
+}
+
+size_t SlidingWindowRLF::delivered() const
+{
+    return _delivered;
+}
+
+size_t SlidingWindowRLF::lost() const
+{
+    return _lost;
+}
+
+const DecoderStats& SlidingWindowRLF::stats() const
+{
+    return _stats;
+}
+
+bool SlidingWindowRLF::feed_row(const char* data, size_t first, size_t count)
+{
+    PhaseTimer timer(_stats, Phase::Feed);
+    ++_stats.symbols_received;
+    if (count == 0 || first + count <= _base)
+    {
+        ++_stats.useless_symbols;
+        return false;
+    }
+    memcpy(_current_payload.data(), data, _symbol_length);
+    // sources before _base are delivered and released, but their payload
+    // stays in the slot until a live column reuses it, so a late symbol can
+    // still be reduced to the live columns
+    auto live = std::max(first, _base);
+    for (auto column = first; column < live; ++column)
+    {
+        if (!GF2::get_bit(_current_hash_bits.data(), column - first))
+            continue;
+        if (column + _capacity < _end || _given_up[column % _capacity])
+        {
+            ++_stats.useless_symbols;
+            return false;
+        }
+        _xor(_current_payload.data(), payload(column), _symbol_length);
+        _stats.bytes_xored += _symbol_length;
+    }
+    while (first + count > _base + _capacity)
+        give_up_oldest();
+    _end = std::max(_end, first + count);
+    // the encoder window has moved at least this far, older sources are
+    // not covered by any later symbol
+    _horizon = std::max(_horizon, _end - std::min(_end, _window));
+
+    std::fill(_current_row.begin(), _current_row.end(), 0);
+    for (auto idx = live - first; idx < count; ++idx)
+        if (GF2::get_bit(_current_hash_bits.data(), idx))
+            GF2::set_bit(_current_row.data(), (first + idx) % _capacity);
+    timer.stop();
+
+    // pivot rows only have coefficients at or after their lead column, so
+    // one ascending pass reduces the new row completely
+    PhaseTimer eliminate_timer(_stats, Phase::Eliminate);
+    auto lead = _end;
+    for (auto column = live; column < _end; ++column)
+    {
+        auto slot = column % _capacity;
+        if (!GF2::get_bit(_current_row.data(), slot))
+            continue;
+        if (_slots[slot] == Slot::Empty)
+        {
+            lead = std::min(lead, column);
+            continue;
+        }
+        if (_slots[slot] == Slot::Known)
+            GF2::clear_bit(_current_row.data(), slot);
+        else
+        {
+            GF2::xor_row(_current_row.data(), row(column), _row_words);
+            ++_stats.row_operations;
+        }
+        _xor(_current_payload.data(), payload(column), _symbol_length);
+        _stats.bytes_xored += _symbol_length;
+    }
+    if (lead == _end)
+    {
+        ++_stats.useless_symbols;
+        return false;
+    }
+
+    std::copy(_current_row.begin(), _current_row.end(), row(lead));
+    memcpy(payload(lead), _current_payload.data(), _symbol_length);
+    _slots[lead % _capacity] = Slot::Pivot;
+    ++_stats.pivots;
+
+    // keep the lead column out of every other row, then any row left with
+    // a single coefficient is a solved source
+    for (auto column = _base; column < lead; ++column)
+    {
+        if (_slots[column % _capacity] != Slot::Pivot || !GF2::get_bit(row(column), lead % _capacity))
+            continue;
+        GF2::xor_row(row(column), row(lead), _row_words);
+        _xor(payload(column), payload(lead), _symbol_length);
+        ++_stats.row_operations;
+        _stats.bytes_xored += _symbol_length;
+        if (GF2::count_bits(row(column), _row_words) == 1)
+            solve(column);
+    }
+    if (GF2::count_bits(row(lead), _row_words) == 1)
+        solve(lead);
+
+    deliver();
+    give_up_stalled();
+    release(std::min(_delivered, _horizon));
+    return true;
+}
+
+void SlidingWindowRLF::solve(size_t column)
+{
+    _slots[column % _capacity] = Slot::Known;
+    std::fill_n(row(column), _row_words, 0);
+    ++_stats.peeling_steps;
+}
+
+// Later symbols never cover columns before _horizon, so a column
+// there without a pivot stays unknown, and so does every row using it
+bool SlidingWindowRLF::stalled(size_t column)
+{
+    auto slot = column % _capacity;
+    if (_slots[slot] != Slot::Pivot)
+        return _slots[slot] == Slot::Empty;
+    for (auto free = column + 1; free < _horizon; ++free)
+        if (_slots[free % _capacity] == Slot::Empty && GF2::get_bit(row(column), free % _capacity))
+            return true;
+    return false;
+}
+
+void SlidingWindowRLF::give_up_stalled()
+{
+    while (_delivered < _horizon && stalled(_delivered))
+        give_up_oldest();
+}
+
+void SlidingWindowRLF::give_up_oldest()
+{
+    if (_delivered == _base)
+    {
+        if (_delivery)
+            _delivery(_base, nullptr);
+        _given_up[_base % _capacity] = true;
+        ++_delivered;
+        ++_lost;
+    }
+    release(_base + 1);
+    deliver();
+}
+
+void SlidingWindowRLF::deliver()
+{
+    while (_delivered < _end && _slots[_delivered % _capacity] == Slot::Known)
+    {
+        if (_delivery)
+            _delivery(_delivered, payload(_delivered));
+        _given_up[_delivered % _capacity] = false;
+        ++_delivered;
+    }
+}
+
+void SlidingWindowRLF::release(size_t base)
+{
+    for (; _base < base; ++_base)
+    {
+        _slots[_base % _capacity] = Slot::Empty;
+        std::fill_n(row(_base), _row_words, 0);
+    }
+    _end = std::max(_end, _base);
+}
+
+uint64_t* SlidingWindowRLF::row(size_t column)
+{
+    return _rows.data() + (column % _capacity) * _row_words;
+}
+
+char* SlidingWindowRLF::payload(size_t column)
+{
+    return _payloads.data() + (column % _capacity) * _symbol_length;
+}
+} // namespace Codes::Fountain
\ No newline at end of file
@@ -0,0 +1,61 @@
+#include "snapshot.h"
+
+#include <fstream>
+
+namespace Codes::Fountain::Snapshot {
+
+void write_header(std::ostream& out, const Header& header, const std::string& key)
+{
+    write(out, header);
+    write(out, static_cast<uint32_t>(key.size()));
+    out.write(key.data(), static_cast<std::streamsize>(key.size()));
+}
+
+bool read_header(std::istream& in, Kind kind, Header& header, std::string& key)
+{
+    uint32_t key_size = 0;
+    if (!read(in, header) || header.magic != magic || header.version != version || header.kind != kind ||
+        !read(in, key_size))
+        return false;
+    key.resize(key_size);
+    return static_cast<bool>(in.read(key.data(), key_size));
+}
+
+void write_stats(std::ostream& out, const DecoderStats& stats)
+{
+    for (auto counter : {stats.symbols_received, stats.redundant_symbols, stats.useless_symbols,
+                         stats.corrupted_symbols, stats.bytes_xored, stats.ripple_high_water, stats.peeling_steps,
+                         stats.pivots, stats.row_operations})
+        write(out, counter);
+    for (auto cycles : stats.phase_cycles)
+        write(out, cycles);
+}
+
+bool read_stats(std::istream& in, DecoderStats& stats)
+{
+    for (auto* counter : {&stats.symbols_received, &stats.redundant_symbols, &stats.useless_symbols,
+                          &stats.corrupted_symbols, &stats.bytes_xored, &stats.ripple_high_water,
+                          &stats.peeling_steps, &stats.pivots, &stats.row_operations})
+        if (!read(in, *counter))
+            return false;
+    for (auto& cycles : stats.phase_cycles)
+        if (!read(in, cycles))
+            return false;
+    return true;
+}
+
+bool append_symbol(const std::string& path, uint64_t number, const char* data, size_t symbol_length)
+{
+    std::ofstream out(path, std::ios::binary | std::ios::app);
+    if (!out)
+        return false;
+    write(out, number);
+    out.write(data, static_cast<std::streamsize>(symbol_length));
+    return static_cast<bool>(out.flush());
+}
+
+bool read_symbol(std::istream& in, size_t symbol_length, uint64_t& number, char* data)
+{
+    return read(in, number) && in.read(data, static_cast<std::streamsize>(symbol_length));
+}
+} // namespace Codes::Fountain::Snapshot
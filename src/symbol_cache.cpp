@@ -0,0 +1,166 @@
+#include "symbol_cache.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace Codes::Fountain {
+
+SymbolRef::SymbolRef(SymbolRef&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+SymbolRef& SymbolRef::operator=(SymbolRef&& other) noexcept
+{
+    if (this == &other)
+        return *this;
+    release();
+    _pins = std::exchange(other._pins, nullptr);
+    _data = std::exchange(other._data, nullptr);
+    _owned = std::move(other._owned);
+    _number = other._number;
+    return *this;
+}
+
+SymbolRef::~SymbolRef()
+{
+    release();
+}
+
+void SymbolRef::release()
+{
+    if (_pins)
+        _pins->fetch_sub(1);
+    _pins = nullptr;
+    _data = nullptr;
+    _owned.reset();
+}
+
+const char* SymbolRef::data() const
+{
+    return _data;
+}
+
+size_t SymbolRef::number() const
+{
+    return _number;
+}
+
+SymbolRef::operator bool() const
+{
+    return _data != nullptr;
+}
+
+SymbolCache::SymbolCache(size_t capacity, size_t symbol_length, Producer producer, size_t ways)
+    : _symbol_length(symbol_length)
+    , _ways(std::max<size_t>(1, std::min(ways, capacity)))
+    , _sets(std::max<size_t>(1, capacity / _ways))
+    , _producer(std::move(producer))
+    , _slots(new Slot[_sets * _ways])
+    , _arena(new char[_sets * _ways * symbol_length])
+    , _hands(_sets, 0)
+{}
+
+SymbolRef SymbolCache::pin(Slot& slot, size_t idx, uint64_t key)
+{
+    // pin first and validate after, eviction publishes busy_slot before it
+    // checks pins, so one of both sides always backs off
+    slot.pins.fetch_add(1);
+    if (slot.key.load() != key)
+    {
+        slot.pins.fetch_sub(1);
+        return {};
+    }
+    slot.referenced.store(true, std::memory_order_relaxed);
+    SymbolRef ref;
+    ref._pins = &slot.pins;
+    ref._data = _arena.get() + idx * _symbol_length;
+    ref._number = key - 1;
+    return ref;
+}
+
+SymbolRef SymbolCache::lookup(size_t number)
+{
+    uint64_t key = number + 1;
+    auto first = (number % _sets) * _ways;
+    for (auto idx = first; idx < first + _ways; ++idx)
+    {
+        if (_slots[idx].key.load() != key)
+            continue;
+        if (auto ref = pin(_slots[idx], idx, key))
+            return ref;
+    }
+    return {};
+}
+
+SymbolRef SymbolCache::get(size_t number)
+{
+    if (auto ref = lookup(number))
+    {
+        _hits.fetch_add(1, std::memory_order_relaxed);
+        return ref;
+    }
+
+    std::lock_guard lock(_producer_mutex);
+    // another reader may have produced it while we waited
+    if (auto ref = lookup(number))
+    {
+        _hits.fetch_add(1, std::memory_order_relaxed);
+        return ref;
+    }
+    _misses.fetch_add(1, std::memory_order_relaxed);
+
+    auto set = number % _sets;
+    auto first = set * _ways;
+    auto& hand = _hands[set];
+    // two sweeps, first one clears reference bits
+    for (auto step = 0u; step < 2 * _ways; ++step)
+    {
+        auto idx = first + hand;
+        hand = (hand + 1) % _ways;
+        auto& slot = _slots[idx];
+        if (slot.pins.load() != 0)
+            continue;
+        if (slot.referenced.exchange(false, std::memory_order_relaxed))
+            continue;
+
+        auto previous = slot.key.exchange(busy_slot);
+        if (slot.pins.load() != 0)
+        {
+            slot.key.store(previous);
+            continue;
+        }
+        _producer(number, _arena.get() + idx * _symbol_length);
+        slot.key.store(number + 1);
+        return pin(slot, idx, number + 1);
+    }
+
+    // every slot of the set is pinned, hand out a private copy
+    SymbolRef ref;
+    ref._owned.reset(new char[_symbol_length]);
+    _producer(number, ref._owned.get());
+    ref._data = ref._owned.get();
+    ref._number = number;
+    return ref;
+}
+
+size_t SymbolCache::symbol_length() const
+{
+    return _symbol_length;
+}
+
+size_t SymbolCache::capacity() const
+{
+    return _sets * _ways;
+}
+
+uint64_t SymbolCache::hits() const
+{
+    return _hits.load(std::memory_order_relaxed);
+}
+
+uint64_t SymbolCache::misses() const
+{
+    return _misses.load(std::memory_order_relaxed);
+}
+} // namespace Codes::Fountain
\ No newline at end of file
@@ -0,0 +1,100 @@
+#include "tabulated_distribution.h"
+
+#include <algorithm>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+
+namespace Codes::Fountain {
+
+TabulatedDistribution::TabulatedDistribution(std::vector<double> probabilities)
+    : _probabilities(std::move(probabilities))
+{
+    for (auto& value : _probabilities)
+        value = std::max(value, 0.0);
+    auto distribution_sum = std::accumulate(_probabilities.cbegin(), _probabilities.cend(), 0.0);
+    if (distribution_sum > 0.0)
+        for (auto& value : _probabilities)
+            value /= distribution_sum;
+}
+
+std::unique_ptr<TabulatedDistribution> TabulatedDistribution::load(const std::string& path)
+{
+    std::ifstream in(path);
+    if (!in)
+        return nullptr;
+    std::vector<double> probabilities;
+    std::string line;
+    while (std::getline(in, line))
+    {
+        line = line.substr(0, line.find('#'));
+        std::istringstream stream(line);
+        size_t degree = 0;
+        double probability = 0.0;
+        if (!(stream >> degree))
+            continue;
+        if (degree == 0 || !(stream >> probability))
+            return nullptr;
+        if (probabilities.size() < degree)
+            probabilities.resize(degree, 0.0);
+        probabilities[degree - 1] += probability;
+    }
+    if (probabilities.empty())
+        return nullptr;
+    return std::make_unique<TabulatedDistribution>(std::move(probabilities));
+}
+
+bool TabulatedDistribution::save(const std::string& path) const
+{
+    std::ofstream out(path, std::ios::trunc);
+    if (!out)
+        return false;
+    out.precision(17);
+    out << "# degree probability\n";
+    for (auto idx = 0u; idx < _probabilities.size(); ++idx)
+        if (_probabilities[idx] != 0.0)
+            out << idx + 1 << " " << _probabilities[idx] << "\n";
+    return static_cast<bool>(out.flush());
+}
+
+const std::vector<double>& TabulatedDistribution::probabilities() const
+{
+    return _probabilities;
+}
+
+void TabulatedDistribution::set_seed(uint32_t seed)
+{
+    _degree_dist.set_seed(seed);
+}
+
+void TabulatedDistribution::set_input_size(size_t input_symbols)
+{
+    _cumulative_probabilities = cumulative_probabilities(expected_distribution(input_symbols), input_symbols);
+}
+
+size_t TabulatedDistribution::symbol_degree()
+{
+    return sample_degree(_cumulative_probabilities, _degree_dist.rand_float());
+}
+
+std::vector<double> TabulatedDistribution::expected_distribution(size_t input_symbols)
+{
+    std::vector<double> expected(input_symbols, 0.0);
+    if (expected.size() == 0)
+        return expected;
+    for (auto idx = 0u; idx < _probabilities.size(); ++idx)
+        expected[std::min<size_t>(idx, input_symbols - 1)] += _probabilities[idx];
+    return expected;
+}
+
+std::string TabulatedDistribution::key() const
+{
+    std::ostringstream stream;
+    stream.precision(17);
+    stream << "tabulated";
+    for (auto idx = 0u; idx < _probabilities.size(); ++idx)
+        if (_probabilities[idx] != 0.0)
+            stream << ":" << idx + 1 << "=" << _probabilities[idx];
+    return stream.str();
+}
+} // namespace Codes::Fountain
@@ -0,0 +1,97 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+
+namespace Codes::Fountain {
+
+namespace {
+thread_local ThreadPool* current_pool = nullptr;
+thread_local size_t current_worker = 0;
+} // namespace
+
+ThreadPool::ThreadPool(size_t threads)
+{
+    threads = std::max<size_t>(threads, 1);
+    for (size_t idx = 0; idx < threads; ++idx)
+        _workers.push_back(std::make_unique<Worker>());
+    for (size_t idx = 0; idx < threads; ++idx)
+        _threads.emplace_back([this, idx] { run(idx); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(_sleep_mutex);
+        _stop = true;
+    }
+    _wake.notify_all();
+    for (auto& thread : _threads)
+        thread.join();
+}
+
+void ThreadPool::post(Task task)
+{
+    auto idx = current_pool == this ? current_worker : _next++ % _workers.size();
+    {
+        // counted before it is queued, so a popped task never underflows _pending
+        std::lock_guard lock(_sleep_mutex);
+        ++_pending;
+    }
+    {
+        std::lock_guard lock(_workers[idx]->mutex);
+        _workers[idx]->tasks.push_back(std::move(task));
+    }
+    _wake.notify_one();
+}
+
+size_t ThreadPool::size() const
+{
+    return _workers.size();
+}
+
+bool ThreadPool::pop(size_t idx, Task& task)
+{
+    auto& worker = *_workers[idx];
+    std::lock_guard lock(worker.mutex);
+    if (worker.tasks.empty())
+        return false;
+    task = std::move(worker.tasks.front());
+    worker.tasks.pop_front();
+    return true;
+}
+
+bool ThreadPool::steal(size_t idx, Task& task)
+{
+    for (size_t offset = 1; offset < _workers.size(); ++offset)
+    {
+        auto& victim = *_workers[(idx + offset) % _workers.size()];
+        std::lock_guard lock(victim.mutex);
+        if (victim.tasks.empty())
+            continue;
+        task = std::move(victim.tasks.back());
+        victim.tasks.pop_back();
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::run(size_t idx)
+{
+    current_pool = this;
+    current_worker = idx;
+    while (true)
+    {
+        Task task;
+        if (pop(idx, task) || steal(idx, task))
+        {
+            --_pending;
+            task();
+            continue;
+        }
+        std::unique_lock lock(_sleep_mutex);
+        _wake.wait(lock, [this] { return _stop || _pending != 0; });
+        if (_stop)
+            return;
+    }
+}
+} // namespace Codes::Fountain
\ No newline at end of file
@@ -0,0 +1,42 @@
+#include "xor_kernel.h"
+
+#include <array>
+#include <iterator>
+#include <utility>
+
+namespace Codes::Fountain {
+
+namespace {
+template <size_t... Idx>
+constexpr auto make_fixed_kernels(std::index_sequence<Idx...>)
+{
+    return std::array<XorKernel, sizeof...(Idx)>{xor_fixed<fixed_symbol_lengths[Idx]>...};
+}
+
+constexpr auto fixed_kernels = make_fixed_kernels(std::make_index_sequence<std::size(fixed_symbol_lengths)>{});
+} // namespace
+
+void xor_generic(char* dst, const char* src, size_t len)
+{
+    size_t idx = 0;
+    for (; idx + sizeof(uint64_t) <= len; idx += sizeof(uint64_t))
+    {
+        uint64_t lhs;
+        uint64_t rhs;
+        memcpy(&lhs, dst + idx, sizeof(lhs));
+        memcpy(&rhs, src + idx, sizeof(rhs));
+        lhs ^= rhs;
+        memcpy(dst + idx, &lhs, sizeof(lhs));
+    }
+    for (; idx < len; ++idx)
+        dst[idx] ^= src[idx];
+}
+
+XorKernel select_xor_kernel(size_t symbol_length)
+{
+    for (size_t idx = 0; idx < fixed_kernels.size(); ++idx)
+        if (fixed_symbol_lengths[idx] == symbol_length)
+            return fixed_kernels[idx];
+    return xor_generic;
+}
+} // namespace Codes::Fountain
\ No newline at end of file
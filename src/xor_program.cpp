@@ -0,0 +1,155 @@
+#include "xor_program.h"
+
+#include <algorithm>
+#include <cstring>
+#include <queue>
+#include <unordered_map>
+
+namespace Codes::Fountain {
+
+namespace {
+struct Candidate
+{
+    uint32_t count = 0;
+    uint64_t key = 0;
+};
+
+uint64_t pair_key(uint32_t lhs, uint32_t rhs)
+{
+    return lhs < rhs ? (uint64_t(lhs) << 32) | rhs : (uint64_t(rhs) << 32) | lhs;
+}
+} // namespace
+
+XorProgram XorProgram::plan(std::span<const std::vector<uint32_t>> neighbor_sets, size_t input_symbols,
+                            size_t max_temporaries)
+{
+    XorProgram program;
+    program._input_symbols = input_symbols;
+    std::vector<std::vector<uint32_t>> sets(neighbor_sets.begin(), neighbor_sets.end());
+    for (auto& set : sets)
+    {
+        std::sort(set.begin(), set.end());
+        program._naive_xor_count += set.empty() ? 0 : set.size() - 1;
+    }
+
+    // pair counts are kept up to date as temporaries replace operands, the
+    // heap holds (count, key) snapshots and stale ones are skipped on pop
+    std::unordered_map<uint64_t, uint32_t> pairs;
+    for (const auto& set : sets)
+        for (size_t first = 0; first < set.size(); ++first)
+            for (size_t second = first + 1; second < set.size(); ++second)
+                ++pairs[pair_key(set[first], set[second])];
+    // most shared pair first, smallest key on ties so plans are reproducible
+    auto lower = [](const Candidate& lhs, const Candidate& rhs) {
+        return lhs.count < rhs.count || (lhs.count == rhs.count && lhs.key > rhs.key);
+    };
+    std::priority_queue<Candidate, std::vector<Candidate>, decltype(lower)> candidates(lower);
+    for (const auto& [key, count] : pairs)
+        if (count > 1)
+            candidates.push({count, key});
+
+    std::vector<uint64_t> touched;
+    while (program._temporaries.size() < max_temporaries && !candidates.empty())
+    {
+        auto best = candidates.top();
+        candidates.pop();
+        auto it = pairs.find(best.key);
+        if (it == pairs.end() || it->second != best.count)
+            continue;
+
+        auto lhs = static_cast<uint32_t>(best.key >> 32);
+        auto rhs = static_cast<uint32_t>(best.key);
+        auto id = static_cast<uint32_t>(input_symbols + program._temporaries.size());
+        program._temporaries.push_back({lhs, rhs});
+        // new id is the largest one, sets stay sorted
+        touched.clear();
+        for (auto& set : sets)
+        {
+            if (!std::binary_search(set.begin(), set.end(), lhs) || !std::binary_search(set.begin(), set.end(), rhs))
+                continue;
+            std::erase_if(set, [&](uint32_t operand) { return operand == lhs || operand == rhs; });
+            --pairs[best.key];
+            for (auto operand : set)
+            {
+                for (auto replaced : {lhs, rhs})
+                {
+                    --pairs[pair_key(operand, replaced)];
+                    touched.push_back(pair_key(operand, replaced));
+                }
+                ++pairs[pair_key(operand, id)];
+                touched.push_back(pair_key(operand, id));
+            }
+            set.push_back(id);
+        }
+        std::sort(touched.begin(), touched.end());
+        touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+        for (auto key : touched)
+            if (auto count = pairs[key]; count > 1)
+                candidates.push({count, key});
+    }
+
+    program._offsets.reserve(sets.size() + 1);
+    program._offsets.push_back(0);
+    for (const auto& set : sets)
+    {
+        program._operands.insert(program._operands.end(), set.begin(), set.end());
+        program._offsets.push_back(program._operands.size());
+    }
+    return program;
+}
+
+size_t XorProgram::outputs() const
+{
+    return _offsets.size() - 1;
+}
+
+size_t XorProgram::temporaries() const
+{
+    return _temporaries.size();
+}
+
+size_t XorProgram::xor_count() const
+{
+    auto count = _temporaries.size();
+    for (size_t output = 0; output < outputs(); ++output)
+        if (_offsets[output + 1] > _offsets[output])
+            count += _offsets[output + 1] - _offsets[output] - 1;
+    return count;
+}
+
+size_t XorProgram::naive_xor_count() const
+{
+    return _naive_xor_count;
+}
+
+void XorProgram::execute(const char* input, size_t symbol_length, XorKernel kernel, char* out,
+                         std::vector<char>& scratch) const
+{
+    scratch.resize(_temporaries.size() * symbol_length);
+    auto operand = [&](uint32_t id) -> const char* {
+        if (id < _input_symbols)
+            return input + id * symbol_length;
+        return scratch.data() + (id - _input_symbols) * symbol_length;
+    };
+
+    for (size_t idx = 0; idx < _temporaries.size(); ++idx)
+    {
+        auto* temporary = scratch.data() + idx * symbol_length;
+        memcpy(temporary, operand(_temporaries[idx].lhs), symbol_length);
+        kernel(temporary, operand(_temporaries[idx].rhs), symbol_length);
+    }
+    for (size_t output = 0; output < outputs(); ++output, out += symbol_length)
+    {
+        auto first = _offsets[output];
+        auto last = _offsets[output + 1];
+        if (first == last)
+        {
+            memset(out, 0, symbol_length);
+            continue;
+        }
+        memcpy(out, operand(_operands[first]), symbol_length);
+        for (auto idx = first + 1; idx < last; ++idx)
+            kernel(out, operand(_operands[idx]), symbol_length);
+    }
+}
+} // namespace Codes::Fountain
@@ -0,0 +1,110 @@
+#include "code_graph.h"
+#include "lt.h"
+#include "robust_soliton_distribution.h"
+#include "symbol_cache.h"
+
+#include <atomic>
+#include <thread>
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+
+using namespace testing;
+
+TEST(SymbolCache, LoopbackClients)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto symbol_length = 16u;
+    auto input_symbols = 200u;
+    auto max_symbols = 1000u;
+    auto total_data_size = symbol_length * input_symbols;
+    auto seed = 13u;
+    auto clients = 8u;
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 7 + 3);
+
+    auto graph = CodeGraph::build_lt(new RobustSolitonDistribution(0.05, 0.03), seed, input_symbols, max_symbols);
+    LT encoder(new RobustSolitonDistribution(0.05, 0.03));
+    encoder.set_code_graph(graph);
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    std::vector<std::atomic<uint32_t>> produced(max_symbols);
+    SymbolCache cache(max_symbols, symbol_length, [&](size_t number, char* out) {
+        ++produced[number];
+        encoder.generate_symbol(number, out);
+    });
+
+    std::vector<std::vector<char>> decoded(clients);
+    std::vector<std::thread> threads;
+    for (auto client = 0u; client < clients; ++client)
+    {
+        threads.emplace_back([&, client] {
+            LT decoder(new RobustSolitonDistribution(0.05, 0.03));
+            decoder.set_code_graph(graph);
+            decoder.set_seed(seed);
+            decoder.set_input_data_size(total_data_size);
+            decoder.set_symbol_length(symbol_length);
+            auto done = false;
+            for (auto number = 0u; !done && number < max_symbols; ++number)
+            {
+                // every client loses a different subset
+                if ((number * 31 + client * 17) % 5 == 0)
+                    continue;
+                auto symbol = cache.get(number);
+                done = decoder.feed_symbol(const_cast<char*>(symbol.data()), number, Memory::MakeCopy);
+            }
+            if (done)
+            {
+                std::unique_ptr<char[]> payload(decoder.decoded_buffer());
+                decoded[client].assign(payload.get(), payload.get() + total_data_size);
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+
+    for (const auto& client_data : decoded)
+        EXPECT_THAT(client_data, Eq(data));
+    for (const auto& count : produced)
+        EXPECT_LE(count.load(), 1u);
+    EXPECT_GT(cache.hits(), 0u);
+}
+
+TEST(SymbolCache, EvictionUnderContention)
+{
+    using namespace Codes::Fountain;
+    auto symbol_length = 8u;
+    auto max_symbols = 256u;
+    auto producer = [symbol_length](size_t number, char* out) {
+        for (auto idx = 0u; idx < symbol_length; ++idx)
+            out[idx] = static_cast<char>(number * 13 + idx);
+    };
+    SymbolCache cache(8, symbol_length, producer, 2);
+    EXPECT_EQ(cache.capacity(), 8u);
+
+    std::atomic<uint32_t> mismatches{0};
+    std::vector<std::thread> threads;
+    for (auto client = 0u; client < 4; ++client)
+    {
+        threads.emplace_back([&, client] {
+            std::vector<char> expected(symbol_length);
+            for (auto iter = 0u; iter < 20'000; ++iter)
+            {
+                auto number = (iter * 7 + client) % max_symbols;
+                auto symbol = cache.get(number);
+                producer(number, expected.data());
+                if (symbol.number() != number || memcmp(symbol.data(), expected.data(), symbol_length) != 0)
+                    ++mismatches;
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+    EXPECT_EQ(mismatches.load(), 0u);
+    EXPECT_GT(cache.misses(), 0u);
+}
\ No newline at end of file
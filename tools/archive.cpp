@@ -0,0 +1,70 @@
+#include "archive.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+int usage()
+{
+    std::fprintf(stderr, "usage: rateless_archive encode <input> <name> <directory>... [--symbol N] [--block N]\n"
+                         "                        [--repair N] [--shards N] [--seed N]\n"
+                         "       rateless_archive decode <name> <output> <directory>...\n");
+    return 2;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    using namespace Codes::Fountain;
+    std::vector<std::string> args(argv + 1, argv + argc);
+    if (args.size() < 4)
+        return usage();
+
+    if (args[0] == "encode")
+    {
+        Archive::Options options;
+        std::vector<std::string> directories;
+        for (auto idx = 3u; idx < args.size(); ++idx)
+        {
+            if (!args[idx].starts_with("--"))
+            {
+                directories.push_back(args[idx]);
+                continue;
+            }
+            if (idx + 1 == args.size())
+                return usage();
+            auto value = std::strtoull(args[idx + 1].c_str(), nullptr, 10);
+            if (args[idx] == "--symbol")
+                options.symbol_length = value;
+            else if (args[idx] == "--block")
+                options.block_symbols = value;
+            else if (args[idx] == "--repair")
+                options.repair_symbols = value;
+            else if (args[idx] == "--shards")
+                options.shards = value;
+            else if (args[idx] == "--seed")
+                options.seed = static_cast<uint32_t>(value);
+            else
+                return usage();
+            ++idx;
+        }
+        if (!Archive::encode(args[1], args[2], directories, options))
+        {
+            std::fprintf(stderr, "encoding %s failed\n", args[1].c_str());
+            return 1;
+        }
+        return 0;
+    }
+    if (args[0] == "decode")
+    {
+        if (!Archive::decode(args[1], {args.begin() + 3, args.end()}, args[2]))
+        {
+            std::fprintf(stderr, "not enough intact symbols to restore %s\n", args[1].c_str());
+            return 1;
+        }
+        return 0;
+    }
+    return usage();
+}
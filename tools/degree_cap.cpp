@@ -0,0 +1,88 @@
+#include "capped_distribution.h"
+#include "ideal_soliton_distribution.h"
+#include "robust_soliton_distribution.h"
+#include "tabulated_distribution.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace {
+int usage()
+{
+    std::fprintf(stderr, "usage: rateless_degree_cap <K> [CAP...] [--samples N] [--threads N] [--xoshiro]\n"
+                         "                           [--ideal | --robust DELTA C | --table FILE]\n");
+    return 2;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    using namespace Codes::Fountain;
+    std::vector<std::string> args(argv + 1, argv + argc);
+    if (args.empty())
+        return usage();
+
+    auto input_symbols = std::strtoull(args[0].c_str(), nullptr, 10);
+    std::vector<size_t> caps;
+    size_t samples = 500;
+    SeedSearch::Options options;
+    SeedSearch::DistributionFactory distribution = [] { return new RobustSolitonDistribution(0.05, 0.03); };
+    std::vector<double> table;
+    for (auto idx = 1u; idx < args.size(); ++idx)
+    {
+        if (!args[idx].starts_with("--"))
+        {
+            caps.push_back(std::strtoull(args[idx].c_str(), nullptr, 10));
+            continue;
+        }
+        if (args[idx] == "--xoshiro")
+            options.generator = PrngType::Xoshiro256;
+        else if (args[idx] == "--ideal")
+            distribution = [] { return new IdealSolitonDistribution(); };
+        else if (idx + 1 == args.size())
+            return usage();
+        else if (args[idx] == "--samples")
+            samples = std::strtoull(args[++idx].c_str(), nullptr, 10);
+        else if (args[idx] == "--threads")
+            options.threads = std::strtoull(args[++idx].c_str(), nullptr, 10);
+        else if (args[idx] == "--table")
+        {
+            auto loaded = TabulatedDistribution::load(args[++idx]);
+            if (!loaded)
+            {
+                std::fprintf(stderr, "can not load %s\n", args[idx].c_str());
+                return 1;
+            }
+            table = loaded->probabilities();
+            distribution = [&table] { return new TabulatedDistribution(table); };
+        }
+        else if (args[idx] == "--robust" && idx + 2 < args.size())
+        {
+            auto delta = std::strtod(args[++idx].c_str(), nullptr);
+            auto c = std::strtod(args[++idx].c_str(), nullptr);
+            distribution = [delta, c] { return new RobustSolitonDistribution(delta, c); };
+        }
+        else
+            return usage();
+    }
+    if (input_symbols == 0)
+        return usage();
+    if (caps.empty())
+    {
+        caps.push_back(0);
+        for (auto cap = input_symbols / 2; cap >= 4; cap /= 2)
+            caps.push_back(cap);
+    }
+
+    std::printf("K = %llu, %zu seeds, overhead in symbols\n", input_symbols, samples);
+    std::printf("%10s %12s %10s %10s %10s\n", "cap", "mean degree", "mean", "worst", "failures");
+    for (const auto& entry : cap_impact(distribution, input_symbols, caps, samples, options))
+    {
+        auto cap = entry.max_degree == 0 ? std::string("none") : std::to_string(entry.max_degree);
+        std::printf("%10s %12.2f %10.2f %10zu %10zu\n", cap.c_str(), entry.mean_degree, entry.mean_overhead,
+                    entry.worst_overhead, entry.failures);
+    }
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include "degree_optimizer.h"
+#include "ideal_soliton_distribution.h"
+#include "robust_soliton_distribution.h"
+#include "tabulated_distribution.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+int usage()
+{
+    std::fprintf(stderr, "usage: rateless_degree_optimizer <K> <output> [--samples N] [--iterations N] [--step X]\n"
+                         "                                [--support D,D,...] [--seed N] [--threads N] [--xoshiro]\n"
+                         "                                [--initial FILE]\n");
+    return 2;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    using namespace Codes::Fountain;
+    std::vector<std::string> args(argv + 1, argv + argc);
+    if (args.size() < 2)
+        return usage();
+
+    auto input_symbols = std::strtoull(args[0].c_str(), nullptr, 10);
+    DegreeOptimizer::Options options;
+    std::vector<double> initial;
+    for (auto idx = 2u; idx < args.size(); ++idx)
+    {
+        if (args[idx] == "--xoshiro")
+        {
+            options.generator = PrngType::Xoshiro256;
+            continue;
+        }
+        if (idx + 1 == args.size())
+            return usage();
+        const auto& value = args[idx + 1];
+        if (args[idx] == "--samples")
+            options.samples = std::strtoull(value.c_str(), nullptr, 10);
+        else if (args[idx] == "--iterations")
+            options.iterations = std::strtoull(value.c_str(), nullptr, 10);
+        else if (args[idx] == "--step")
+            options.step = std::strtod(value.c_str(), nullptr);
+        else if (args[idx] == "--seed")
+            options.seed = static_cast<uint32_t>(std::strtoul(value.c_str(), nullptr, 10));
+        else if (args[idx] == "--threads")
+            options.threads = std::strtoull(value.c_str(), nullptr, 10);
+        else if (args[idx] == "--support")
+        {
+            std::istringstream stream(value);
+            for (std::string degree; std::getline(stream, degree, ',');)
+                options.support.push_back(std::strtoull(degree.c_str(), nullptr, 10));
+        }
+        else if (args[idx] == "--initial")
+        {
+            auto distribution = TabulatedDistribution::load(value);
+            if (!distribution)
+            {
+                std::fprintf(stderr, "can not load %s\n", value.c_str());
+                return 1;
+            }
+            initial = distribution->probabilities();
+        }
+        else
+            return usage();
+        ++idx;
+    }
+    if (input_symbols == 0)
+        return usage();
+
+    // fresh seeds, so the reported overheads are not the ones optimised for
+    auto validation = static_cast<uint32_t>(options.samples + 1);
+    auto ideal = DegreeOptimizer::mean_overhead([] { return new IdealSolitonDistribution(); }, input_symbols,
+                                                validation, options.samples, options);
+    auto robust = DegreeOptimizer::mean_overhead([] { return new RobustSolitonDistribution(0.05, 0.03); },
+                                                 input_symbols, validation, options.samples, options);
+    auto result = DegreeOptimizer::optimize(input_symbols, options, initial);
+    auto optimized = DegreeOptimizer::mean_overhead(
+        [&] { return new TabulatedDistribution(result.probabilities); }, input_symbols, validation, options.samples,
+        options);
+
+    std::printf("mean overhead for K = %llu over %zu validation seeds\n", input_symbols, options.samples);
+    std::printf("  ideal soliton          %8.2f\n", ideal);
+    std::printf("  robust soliton         %8.2f\n", robust);
+    std::printf("  optimised              %8.2f (%.2f on training seeds, %zu steps kept)\n", optimized,
+                result.mean_overhead, result.accepted);
+    if (!TabulatedDistribution(result.probabilities).save(args[1]))
+    {
+        std::fprintf(stderr, "can not write %s\n", args[1].c_str());
+        return 1;
+    }
+    return 0;
+}
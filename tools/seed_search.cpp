@@ -0,0 +1,105 @@
+#include "ideal_soliton_distribution.h"
+#include "robust_soliton_distribution.h"
+#include "seed_search.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+int usage()
+{
+    std::fprintf(stderr, "usage: rateless_seed_search rlf|lt <K> [--first N] [--count N] [--top N] [--trials N]\n"
+                         "                            [--loss P] [--max-overhead N] [--threads N] [--xoshiro]\n"
+                         "                            [--ideal | --robust DELTA C]\n");
+    return 2;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    using namespace Codes::Fountain;
+    std::vector<std::string> args(argv + 1, argv + argc);
+    if (args.size() < 2 || (args[0] != "rlf" && args[0] != "lt"))
+        return usage();
+
+    auto input_symbols = std::strtoull(args[1].c_str(), nullptr, 10);
+    uint32_t first = 1;
+    size_t count = 1000;
+    size_t top = 10;
+    SeedSearch::Options options;
+    double delta = 0.05;
+    double c = 0.03;
+    auto ideal = false;
+    for (auto idx = 2u; idx < args.size(); ++idx)
+    {
+        auto value = [&](size_t offset = 1) -> const char* {
+            return idx + offset < args.size() ? args[idx + offset].c_str() : nullptr;
+        };
+        if (args[idx] == "--xoshiro")
+        {
+            options.generator = PrngType::Xoshiro256;
+            continue;
+        }
+        if (args[idx] == "--ideal")
+        {
+            ideal = true;
+            continue;
+        }
+        if (!value())
+            return usage();
+        if (args[idx] == "--first")
+            first = static_cast<uint32_t>(std::strtoul(value(), nullptr, 10));
+        else if (args[idx] == "--count")
+            count = std::strtoull(value(), nullptr, 10);
+        else if (args[idx] == "--top")
+            top = std::strtoull(value(), nullptr, 10);
+        else if (args[idx] == "--trials")
+            options.trials = std::strtoull(value(), nullptr, 10);
+        else if (args[idx] == "--loss")
+            options.loss = std::strtod(value(), nullptr);
+        else if (args[idx] == "--max-overhead")
+            options.max_overhead = std::strtoull(value(), nullptr, 10);
+        else if (args[idx] == "--threads")
+            options.threads = std::strtoull(value(), nullptr, 10);
+        else if (args[idx] == "--robust" && value(2))
+        {
+            delta = std::strtod(value(), nullptr);
+            c = std::strtod(value(2), nullptr);
+            ++idx;
+        }
+        else
+            return usage();
+        ++idx;
+    }
+    if (input_symbols == 0)
+        return usage();
+
+    std::vector<SeedSearch::Score> scores;
+    std::string key;
+    if (args[0] == "rlf")
+        scores = SeedSearch::search_rlf(input_symbols, first, count, options);
+    else
+    {
+        SeedSearch::DistributionFactory distribution = [&]() -> DegreeDistribution* {
+            if (ideal)
+                return new IdealSolitonDistribution();
+            return new RobustSolitonDistribution(delta, c);
+        };
+        key = std::unique_ptr<DegreeDistribution>(distribution())->key();
+        scores = SeedSearch::search_lt(distribution, input_symbols, first, count, options);
+    }
+
+    std::printf("%10s %10s %10s %10s\n", "seed", "lossless", "mean", "max");
+    for (auto idx = 0u; idx < std::min(top, scores.size()); ++idx)
+        std::printf("%10u %10zu %10.2f %10zu\n", scores[idx].seed, scores[idx].lossless_overhead,
+                    scores[idx].mean_overhead, scores[idx].max_overhead);
+    // ready to paste into the recommendations table
+    if (!scores.empty())
+        std::printf("{CodeGraph::Kind::%s, PrngType::%s, \"%s\", %llu, %u, %zu},\n", args[0] == "rlf" ? "Rlf" : "Lt",
+                    options.generator == PrngType::Well512 ? "Well512" : "Xoshiro256", key.c_str(), input_symbols,
+                    scores.front().seed, scores.front().lossless_overhead);
+    return 0;
+}
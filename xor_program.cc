@@ -0,0 +1,125 @@
+#include "lt.h"
+#include "robust_soliton_distribution.h"
+#include "xor_program.h"
+
+#include <chrono>
+
+#include <gmock/gmock-matchers.h>
+#include <gtest/gtest.h>
+#include <spdlog/spdlog.h>
+
+using namespace testing;
+
+TEST(XorProgram, SharedPairs)
+{
+    using namespace Codes::Fountain;
+    auto symbol_length = 4u;
+    auto input_symbols = 6u;
+    std::vector<std::vector<uint32_t>> sets{{0, 1, 2}, {0, 1, 3}, {0, 1, 2, 4}, {5}, {}};
+    auto program = XorProgram::plan(sets, input_symbols);
+    // {0, 1} first, then {0 ^ 1, 2}
+    EXPECT_EQ(program.temporaries(), 2u);
+    EXPECT_EQ(program.naive_xor_count(), 7u);
+    EXPECT_EQ(program.xor_count(), 4u);
+
+    std::vector<char> input(input_symbols * symbol_length);
+    for (auto idx = 0u; idx < input.size(); ++idx)
+        input[idx] = static_cast<char>(idx * 29 + 5);
+    std::vector<char> out(sets.size() * symbol_length, 0x55);
+    std::vector<char> scratch;
+    program.execute(input.data(), symbol_length, xor_generic, out.data(), scratch);
+    for (auto output = 0u; output < sets.size(); ++output)
+    {
+        std::vector<char> expected(symbol_length, 0);
+        for (auto neighbor : sets[output])
+            xor_generic(expected.data(), input.data() + neighbor * symbol_length, symbol_length);
+        ASSERT_EQ(memcmp(out.data() + output * symbol_length, expected.data(), symbol_length), 0);
+    }
+}
+
+TEST(XorProgram, LTRepairBurst)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto symbol_length = 16u;
+    auto input_symbols = 500u;
+    auto total_data_size = symbol_length * input_symbols;
+    auto burst = 64u;
+    auto seed = 13u;
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 7 + 3);
+
+    LT encoder(new RobustSolitonDistribution(0.05, 0.03));
+    encoder.set_seed(seed);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    std::vector<char> batch(burst * symbol_length);
+    encoder.generate_symbols(100, burst, batch.data());
+    std::vector<std::vector<uint32_t>> sets;
+    std::vector<char> symbol(symbol_length);
+    for (auto idx = 0u; idx < burst; ++idx)
+    {
+        encoder.generate_symbol(100 + idx, symbol.data());
+        ASSERT_EQ(memcmp(batch.data() + idx * symbol_length, symbol.data(), symbol_length), 0);
+        sets.emplace_back(encoder._current_hash_bits);
+    }
+    auto program = XorProgram::plan(sets, input_symbols);
+    EXPECT_LT(program.xor_count(), program.naive_xor_count());
+}
+
+TEST(XorProgram, CachedPlanReused)
+{
+    spdlog::set_level(spdlog::level::debug);
+    using namespace Codes::Fountain;
+    auto symbol_length = 1024u;
+    auto input_symbols = 256u;
+    auto total_data_size = symbol_length * input_symbols;
+    auto burst = 256u;
+    auto rounds = 10u;
+    std::vector<char> data(total_data_size);
+    for (auto idx = 0u; idx < total_data_size; ++idx)
+        data[idx] = static_cast<char>(idx * 7 + 3);
+
+    LT encoder(new RobustSolitonDistribution(0.05, 0.03));
+    encoder.set_seed(13);
+    encoder.set_input_data(data.data(), data.size());
+    encoder.set_symbol_length(symbol_length);
+
+    auto measure = [&](auto&& encode) {
+        auto start = std::chrono::steady_clock::now();
+        for (auto round = 0u; round < rounds; ++round)
+            encode();
+        return std::chrono::steady_clock::now() - start;
+    };
+    std::vector<char> batch(burst * symbol_length);
+    std::vector<char> single(burst * symbol_length);
+    // neighbour sets are only built when the range gets planned
+    encoder.generate_symbols(0, burst, batch.data());
+    encoder._batch_sets.clear();
+    // timings are informational, best of interleaved runs
+    auto planned = std::chrono::steady_clock::duration::max();
+    auto separate = std::chrono::steady_clock::duration::max();
+    for (auto trial = 0; trial < 9; ++trial)
+    {
+        planned = std::min(planned, measure([&] { encoder.generate_symbols(0, burst, batch.data()); }));
+        separate = std::min(separate, measure([&] {
+                                for (auto idx = 0u; idx < burst; ++idx)
+                                    encoder.generate_symbol(idx, single.data() + idx * symbol_length);
+                            }));
+    }
+    ASSERT_EQ(memcmp(batch.data(), single.data(), batch.size()), 0);
+
+    // only the very first call planned the range, later ones reused it
+    EXPECT_TRUE(encoder._batch_sets.empty());
+    ASSERT_TRUE(encoder._batch_program.has_value());
+    EXPECT_LT(encoder._batch_program->xor_count(), encoder._batch_program->naive_xor_count());
+    spdlog::debug("Burst of {} symbols, batched {}us, one by one {}us", burst,
+                  std::chrono::duration_cast<std::chrono::microseconds>(planned).count(),
+                  std::chrono::duration_cast<std::chrono::microseconds>(separate).count());
+
+    // another range is planned again
+    encoder.generate_symbols(burst, burst, batch.data());
+    EXPECT_EQ(encoder._batch_sets.size(), burst);
+}